@@ -213,7 +213,13 @@ struct Polynomial : Algebraic {
         for (auto const &[rm, rr] : v.coefficients_) {
           auto [iter, inserted] = coefficients_.try_emplace(
               lm * rm, base::Lazy([lr = &lr, rr = &rr] { return *lr * *rr; }));
-          if (not inserted) { iter->second += lr * rr; }
+          if (not inserted) {
+            if constexpr (requires { iter->second.AddMul(lr, rr); }) {
+              iter->second.AddMul(lr, rr);
+            } else {
+              iter->second += lr * rr;
+            }
+          }
         }
       }
 
@@ -0,0 +1,129 @@
+#ifndef CHALK_COMBINATORICS_CONSTANT_TABLES_H
+#define CHALK_COMBINATORICS_CONSTANT_TABLES_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+
+#include "chalk/fixed_integer.h"
+
+// Tables of combinatorial quantities, computed in constant evaluation. Each
+// table is sized by a template parameter and holds `FixedInteger`s wide enough
+// for its largest entry, so that it may initialize a `constexpr` variable and
+// be read at run time without any computation. For example,
+//
+//   constexpr auto kCatalan = CatalanTable<64>();
+//   static_assert(kCatalan[5] == 42);
+namespace chalk {
+namespace internal_constant_tables {
+
+// Returns the largest `r` with `r * r <= n`.
+constexpr size_t SquareRoot(size_t n) {
+  size_t r = 0;
+  while ((r + 1) * (r + 1) <= n) { ++r; }
+  return r;
+}
+
+// Bounds on the number of bits in the entries of each table of size `n`.
+// Factorials are bounded by the product of the powers of two above each
+// factor. Catalan numbers are less than `4^k`, with room to multiply by the
+// numerator of the ratio of consecutive entries before dividing by its
+// denominator. Partition counts are less than `e^(pi * sqrt(2k / 3))`, or
+// `2^(3.7007 * sqrt(k))`, with two bits to spare for the partial sums of the
+// pentagonal number recurrence.
+constexpr size_t FactorialBits(size_t n) {
+  size_t bits = 1;
+  for (size_t k = 2; k < n; ++k) { bits += std::bit_width(k); }
+  return bits;
+}
+constexpr size_t CatalanBits(size_t n) { return 2 * n + std::bit_width(n); }
+constexpr size_t PartitionCountBits(size_t n) {
+  return 3701 * (SquareRoot(n) + 1) / 1000 + 3;
+}
+
+}  // namespace internal_constant_tables
+
+// Returns `k!` for `0 <= k < N`.
+template <size_t N>
+constexpr auto FactorialTable() {
+  std::array<FixedInteger<internal_constant_tables::FactorialBits(N)>, N>
+      table{};
+  for (size_t k = 0; k < N; ++k) {
+    table[k] = k == 0 ? 1 : table[k - 1];
+    if (k > 1) { table[k] *= k; }
+  }
+  return table;
+}
+
+// Returns the binomial coefficients `n choose k` for `0 <= k <= n < N`, with
+// `n choose k` at index `BinomialIndex(n, k)`. Each row of Pascal's triangle is
+// formed by adding adjacent entries of the previous row.
+constexpr size_t BinomialIndex(size_t n, size_t k) {
+  return n * (n + 1) / 2 + k;
+}
+template <size_t N>
+constexpr auto BinomialTable() {
+  static_assert(N > 0);
+  // Every entry of row `n` is less than `2^n`.
+  std::array<FixedInteger<std::max<size_t>(N - 1, 1)>, N * (N + 1) / 2>
+      table{};
+  for (size_t n = 0; n < N; ++n) {
+    table[BinomialIndex(n, 0)] = 1;
+    table[BinomialIndex(n, n)] = 1;
+    for (size_t k = 1; k < n; ++k) {
+      table[BinomialIndex(n, k)] = table[BinomialIndex(n - 1, k - 1)] +
+                                   table[BinomialIndex(n - 1, k)];
+    }
+  }
+  return table;
+}
+
+// Returns the Catalan numbers `C(k)` for `0 <= k < N`, using
+// `C(k) = C(k - 1) * 2 * (2k - 1) / (k + 1)`.
+template <size_t N>
+constexpr auto CatalanTable() {
+  std::array<FixedInteger<internal_constant_tables::CatalanBits(N)>, N>
+      table{};
+  for (size_t k = 0; k < N; ++k) {
+    if (k == 0) {
+      table[k] = 1;
+      continue;
+    }
+    table[k] = table[k - 1];
+    table[k] *= 2 * (2 * k - 1);
+    table[k] /= k + 1;
+  }
+  return table;
+}
+
+// Returns the number of partitions `p(k)` of each `0 <= k < N`, by Euler's
+// pentagonal number recurrence
+//   `p(k) = sum over j >= 1 of (-1)^(j + 1) * (p(k - j(3j - 1) / 2) +
+//                                              p(k - j(3j + 1) / 2))`.
+template <size_t N>
+constexpr auto PartitionCountTable() {
+  std::array<FixedInteger<internal_constant_tables::PartitionCountBits(N)>, N>
+      table{};
+  for (size_t k = 0; k < N; ++k) {
+    if (k == 0) {
+      table[k] = 1;
+      continue;
+    }
+    for (size_t j = 1; j * (3 * j - 1) / 2 <= k; ++j) {
+      size_t pentagonal = j * (3 * j - 1) / 2;
+      auto term         = table[k - pentagonal];
+      if (pentagonal + j <= k) { term += table[k - pentagonal - j]; }
+      if (j % 2 == 1) {
+        table[k] += term;
+      } else {
+        table[k] -= term;
+      }
+    }
+  }
+  return table;
+}
+
+}  // namespace chalk
+
+#endif  // CHALK_COMBINATORICS_CONSTANT_TABLES_H
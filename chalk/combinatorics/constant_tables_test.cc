@@ -0,0 +1,59 @@
+#include "chalk/combinatorics/constant_tables.h"
+
+#include "chalk/integer.h"
+#include "gtest/gtest.h"
+
+namespace chalk {
+namespace {
+
+constexpr auto kFactorials     = FactorialTable<30>();
+constexpr auto kBinomials      = BinomialTable<10>();
+constexpr auto kCatalanNumbers = CatalanTable<20>();
+constexpr auto kPartitions     = PartitionCountTable<100>();
+
+static_assert(kFactorials[0] == 1);
+static_assert(kFactorials[1] == 1);
+static_assert(kFactorials[20] == 2432902008176640000);
+static_assert(kFactorials[29] / kFactorials[27] == 29 * 28);
+
+static_assert(kBinomials[BinomialIndex(0, 0)] == 1);
+static_assert(kBinomials[BinomialIndex(9, 0)] == 1);
+static_assert(kBinomials[BinomialIndex(9, 4)] == 126);
+static_assert(kBinomials[BinomialIndex(9, 9)] == 1);
+
+static_assert(kCatalanNumbers[0] == 1);
+static_assert(kCatalanNumbers[1] == 1);
+static_assert(kCatalanNumbers[5] == 42);
+static_assert(kCatalanNumbers[19] == 1767263190);
+
+static_assert(kPartitions[0] == 1);
+static_assert(kPartitions[1] == 1);
+static_assert(kPartitions[5] == 7);
+static_assert(kPartitions[10] == 42);
+static_assert(kPartitions[99] == 169229875);
+
+TEST(ConstantTables, BinomialRowsSumToPowersOfTwo) {
+  for (size_t n = 0; n < 10; ++n) {
+    Integer sum = 0;
+    for (size_t k = 0; k <= n; ++k) {
+      sum += kBinomials[BinomialIndex(n, k)].ToInteger();
+    }
+    EXPECT_EQ(sum, 1 << n);
+  }
+}
+
+TEST(ConstantTables, LargeEntries) {
+  constexpr auto factorials = FactorialTable<256>();
+  Integer expected          = 1;
+  for (uint64_t n = 1; n < 256; ++n) {
+    expected *= n;
+    EXPECT_EQ(factorials[n].ToInteger(), expected);
+  }
+
+  constexpr auto partitions = PartitionCountTable<256>();
+  EXPECT_EQ(partitions[255].ToInteger(),
+            Integer(uint64_t{338854264248680}));
+}
+
+}  // namespace
+}  // namespace chalk
@@ -3,10 +3,16 @@
 #include <iostream>
 
 #include "absl/functional/function_ref.h"
+#include "chalk/combinatorics/constant_tables.h"
 
 namespace chalk {
 namespace {
 
+// Catalan numbers of arguments below this bound are read from a table computed
+// at compile time.
+constexpr size_t kCatalanTableSize = 64;
+constexpr auto kCatalanNumbers     = CatalanTable<kCatalanTableSize>();
+
 void BounceImpl(DyckPath const& path,
                 absl::FunctionRef<void(size_t)> handle_part_size) {
   size_t height        = 0;
@@ -129,6 +135,16 @@ std::vector<DyckPath> DyckPath::All(size_t n) {
   return results;
 }
 
+Integer DyckPath::Count(size_t n) {
+  if (n < kCatalanTableSize) { return kCatalanNumbers[n].ToInteger(); }
+  Integer result = kCatalanNumbers.back().ToInteger();
+  for (size_t k = kCatalanTableSize; k <= n; ++k) {
+    result *= 2 * (2 * k - 1);
+    result = DivExactByWord(result, k + 1);
+  }
+  return result;
+}
+
 Image ChalkVisualize(DyckPath const& path) {
   std::vector<std::string> result{""};
   size_t height  = 0;
@@ -7,6 +7,7 @@
 
 #include "chalk/combinatorics/composition.h"
 #include "chalk/combinatorics/image.h"
+#include "chalk/integer.h"
 
 namespace chalk {
 
@@ -54,6 +55,10 @@ struct DyckPath {
   // and `n` downsteps.
   static std::vector<DyckPath> All(size_t n);
 
+  // Returns the number of `DyckPath`s consisting of `n` upsteps and `n`
+  // downsteps, which is the `n`th Catalan number.
+  static Integer Count(size_t n);
+
   // Returns the `DyckPath` constructed by concatenating `*this` and `rhs
   // together.
   DyckPath &operator+=(DyckPath const &rhs);
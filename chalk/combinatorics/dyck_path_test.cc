@@ -352,4 +352,18 @@ TEST(DyckPath, Topple) {
                             DyckPath::Step::Down, DyckPath::Step::Down}));
 }
 
+TEST(DyckPath, Count) {
+  for (size_t n = 0; n < 8; ++n) {
+    EXPECT_EQ(DyckPath::Count(n), DyckPath::All(n).size()) << "n = " << n;
+  }
+  EXPECT_EQ(DyckPath::Count(63),
+            *Integer::Parse("94295850558771979787935384946380125"));
+  // Beyond the table.
+  EXPECT_EQ(DyckPath::Count(64),
+            *Integer::Parse("368479169875816659479009042713546950"));
+  EXPECT_EQ(DyckPath::Count(100),
+            *Integer::Parse("8965199470901314966871700700741006324208375215"
+                            "38745909320"));
+}
+
 }  // namespace chalk
@@ -1,11 +1,116 @@
 #include "chalk/combinatorics/partition.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "chalk/combinatorics/constant_tables.h"
+
 namespace chalk {
+namespace {
+
+// Factorials, binomial coefficients and partition counts of arguments below
+// these bounds are read from tables computed at compile time.
+constexpr uint64_t kFactorialTableSize      = 256;
+constexpr uint64_t kBinomialTableSize       = 65;
+constexpr uint64_t kPartitionCountTableSize = 256;
+
+constexpr auto kFactorials = FactorialTable<kFactorialTableSize>();
+constexpr auto kBinomials  = BinomialTable<kBinomialTableSize>();
+constexpr auto kPartitionCounts =
+    PartitionCountTable<kPartitionCountTableSize>();
+
+// Returns the primes no greater than `n`, by the sieve of Eratosthenes.
+std::vector<uint64_t> Primes(uint64_t n) {
+  std::vector<uint64_t> primes;
+  std::vector<bool> composite(n + 1, false);
+  for (uint64_t p = 2; p <= n; ++p) {
+    if (composite[p]) { continue; }
+    primes.push_back(p);
+    for (uint64_t multiple = p * p; multiple <= n; multiple += p) {
+      composite[multiple] = true;
+    }
+  }
+  return primes;
+}
+
+// Returns the swinging factorial `n! / (floor(n / 2)!)^2`. A prime `p` divides
+// it to the number of odd values among `floor(n / p^i)` for `i >= 1`, so that
+// it is a product of small prime powers, which are packed into machine words
+// before the product is formed.
+Integer Swing(uint64_t n, std::vector<uint64_t> const &primes) {
+  std::vector<uint64_t> words;
+  uint64_t word = 1;
+  for (uint64_t p : primes) {
+    if (p > n) { break; }
+    for (uint64_t q = n / p; q != 0; q /= p) {
+      if (q % 2 == 0) { continue; }
+      if (word > std::numeric_limits<uint64_t>::max() / p) {
+        words.push_back(word);
+        word = 1;
+      }
+      word *= p;
+    }
+  }
+  words.push_back(word);
+  return ProductOf(words);
+}
+
+// Luschny's prime-swing algorithm: `n! = (floor(n / 2)!)^2 * swing(n)`, where
+// the swinging factorial is far cheaper to compute than the factorial, and
+// the recursion bottoms out in the table.
+Integer SwingFactorial(uint64_t n, std::vector<uint64_t> const &primes) {
+  if (n < kFactorialTableSize) { return kFactorials[n].ToInteger(); }
+  return SwingFactorial(n / 2, primes).Square() * Swing(n, primes);
+}
+
+}  // namespace
 
 Integer Factorial(uint64_t n) {
+  if (n < kFactorialTableSize) { return kFactorials[n].ToInteger(); }
+  return SwingFactorial(n, Primes(n));
+}
+
+Integer Binomial(uint64_t n, uint64_t k) {
+  if (k > n) { return 0; }
+  if (n < kBinomialTableSize) {
+    return kBinomials[BinomialIndex(n, k)].ToInteger();
+  }
+  // Each partial product `(n - k + 1) * ... * (n - k + i)` is divisible by
+  // `i!`, so every division below is exact.
+  k              = std::min(k, n - k);
   Integer result = 1;
-  for (uint64_t i = 1; i <= n; ++i) { result *= i; }
+  for (uint64_t i = 1; i <= k; ++i) {
+    result *= n - k + i;
+    result = DivExactByWord(result, i);
+  }
   return result;
 }
 
+Integer PartitionCount(uint64_t n) {
+  if (n < kPartitionCountTableSize) { return kPartitionCounts[n].ToInteger(); }
+  // Extend the table by Euler's pentagonal number recurrence.
+  std::vector<Integer> counts;
+  counts.reserve(n + 1);
+  for (auto const &count : kPartitionCounts) {
+    counts.push_back(count.ToInteger());
+  }
+  for (uint64_t m = kPartitionCountTableSize; m <= n; ++m) {
+    Integer count = 0;
+    for (uint64_t j = 1; j * (3 * j - 1) / 2 <= m; ++j) {
+      uint64_t pentagonal = j * (3 * j - 1) / 2;
+      Integer term        = counts[m - pentagonal];
+      if (pentagonal + j <= m) { term += counts[m - pentagonal - j]; }
+      if (j % 2 == 1) {
+        count += term;
+      } else {
+        count -= term;
+      }
+    }
+    counts.push_back(std::move(count));
+  }
+  return std::move(counts.back());
+}
+
 }  // namespace chalk
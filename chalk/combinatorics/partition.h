@@ -7,6 +7,7 @@
 #include <iostream>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "chalk/base/iterator.h"
 #include "chalk/combinatorics/composition.h"
@@ -179,36 +180,52 @@ struct BasicPartition : private BasicComposition<PartType> {
 using Partition = BasicPartition<uint8_t>;
 
 // Computes the product of all positive integers less than or equal to `n`.
+// Small factorials are read from a table computed at compile time; large ones
+// are computed by Luschny's prime-swing algorithm with balanced products.
 Integer Factorial(uint64_t n);
 
+// Returns the binomial coefficient `n choose k`, which is zero if `k > n`.
+// Coefficients with small `n` are read from a table computed at compile time.
+Integer Binomial(uint64_t n, uint64_t k);
+
+// Returns the number of partitions of `n`. Counts for small `n` are read from a
+// table computed at compile time, and extended beyond it by Euler's pentagonal
+// number recurrence.
+Integer PartitionCount(uint64_t n);
+
 // Computes the factorial of the partition `p`. That is, the product of the
 // factorial of all of the parts in the partition.
 template <std::integral PartType>
 Integer Factorial(BasicPartition<PartType> const &p) {
-  Integer result = 1;
-  for (uint64_t n : p) { result *= Factorial(n); }
-  return result;
+  std::vector<Integer> factorials;
+  for (uint64_t n : p) {
+    if (n > 1) { factorials.push_back(Factorial(n)); }
+  }
+  return ProductOf(factorials);
 }
 
 // Returns the number of permutations in the symmetric group with cycle-type
 // `p`.
 template <std::integral PartType>
 Integer CycleTypeCount(BasicPartition<PartType> const &p) {
-  Integer denominator     = 1;
-  PartType last_part_size = 0;
-  auto const next_largest = [&](PartType n) { return n != last_part_size; };
-  auto iter               = p.cbegin();
+  // These permutations form a conjugacy class, whose size is `n!` divided by
+  // the order of a centralizer: the product over the distinct part sizes `k`
+  // of `k^m * m!`, where `m` is the multiplicity of `k`. Forming that order
+  // first means `n!` is divided only once, and exactly.
+  std::vector<Integer> factorials;
+  std::vector<uint64_t> parts;
+  auto iter = p.cbegin();
   while (iter != p.cend()) {
-    auto next_iter = std::find_if(iter, p.cend(), next_largest);
-    denominator *= Factorial(std::distance(iter, next_iter));
-    iter           = next_iter;
-    last_part_size = *iter;
+    PartType part  = *iter;
+    auto next_iter = std::find_if(iter, p.cend(),
+                                  [&](PartType n) { return n != part; });
+    uint64_t multiplicity = std::distance(iter, next_iter);
+    if (multiplicity > 1) { factorials.push_back(Factorial(multiplicity)); }
+    if (part > 1) { parts.insert(parts.end(), multiplicity, part); }
+    iter = next_iter;
   }
-
-  Integer numerator = Factorial(p.whole());
-  for (uint64_t n : p) { numerator /= n; }
-
-  return numerator / denominator;
+  factorials.push_back(ProductOf(parts));
+  return DivExact(Factorial(p.whole()), ProductOf(factorials));
 }
 
 // Returns the rank of the partition `p`. That is, returns the largest value
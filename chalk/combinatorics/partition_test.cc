@@ -1,5 +1,9 @@
 #include "chalk/combinatorics/partition.h"
 
+#include <thread>
+#include <vector>
+
+#include "chalk/limb_allocator.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -78,6 +82,85 @@ TEST(Factorial, Correct) {
   EXPECT_EQ(Factorial(10), 3628800);
 }
 
+TEST(Factorial, Large) {
+  // Arguments on either side of the cached range, and large enough for the
+  // products to use subquadratic multiplication.
+  Integer expected = 1;
+  for (uint64_t n = 1; n <= 5000; ++n) {
+    expected *= n;
+    if (n == 255 or n == 256 or n == 257 or n == 1000 or n == 4099 or
+        n == 5000) {
+      EXPECT_EQ(Factorial(n), expected) << "n = " << n;
+    }
+  }
+}
+
+TEST(Factorial, Concurrent) {
+  std::vector<std::thread> threads;
+  std::vector<Integer> results(8);
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i] { results[i] = Factorial(100 + 50 * i); });
+  }
+  for (std::thread &t : threads) { t.join(); }
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i], Factorial(99 + 50 * i) * (100 + 50 * i));
+  }
+}
+
+// Forwards to the default allocator, counting the allocations made.
+struct CountingAllocator : LimbAllocator {
+  uint64_t *Allocate(size_t n) override {
+    ++allocations;
+    return DefaultLimbAllocator().Allocate(n);
+  }
+  void Deallocate(uint64_t *ptr, size_t n) override {
+    DefaultLimbAllocator().Deallocate(ptr, n);
+  }
+
+  size_t allocations = 0;
+};
+
+TEST(Factorial, SmallValuesDoNotAllocate) {
+  CountingAllocator counting;
+  ScopedLimbAllocator scope(counting);
+  // 34! is the largest factorial fitting in two limbs.
+  for (uint64_t n = 0; n <= 34; ++n) { Integer f = Factorial(n); }
+  EXPECT_EQ(counting.allocations, 0);
+  EXPECT_EQ(Factorial(34) / Factorial(33), 34);
+  EXPECT_EQ(counting.allocations, 0);
+}
+
+TEST(Binomial, Correct) {
+  EXPECT_EQ(Binomial(0, 0), 1);
+  EXPECT_EQ(Binomial(5, 2), 10);
+  EXPECT_EQ(Binomial(5, 6), 0);
+  EXPECT_EQ(Binomial(64, 32), uint64_t{1832624140942590534});
+  // Beyond the table.
+  EXPECT_EQ(Binomial(65, 0), 1);
+  EXPECT_EQ(Binomial(65, 65), 1);
+  EXPECT_EQ(Binomial(100, 50),
+            *Integer::Parse("100891344545564193334812497256"));
+  EXPECT_EQ(Binomial(100, 97), 161700);
+}
+
+TEST(PartitionCount, Correct) {
+  EXPECT_EQ(PartitionCount(0), 1);
+  EXPECT_EQ(PartitionCount(4), 5);
+  EXPECT_EQ(PartitionCount(10), 42);
+  EXPECT_EQ(PartitionCount(255), uint64_t{338854264248680});
+  // Beyond the table.
+  EXPECT_EQ(PartitionCount(256), uint64_t{365749566870782});
+  EXPECT_EQ(PartitionCount(299), uint64_t{8620496275465025});
+}
+
+TEST(PartitionCount, MatchesEnumeration) {
+  for (uint8_t n = 1; n < 20; ++n) {
+    uint64_t count = 0;
+    for ([[maybe_unused]] auto const &p : Partition::All(n)) { ++count; }
+    EXPECT_EQ(PartitionCount(n), count) << "n = " << int{n};
+  }
+}
+
 TEST(Partition, Factorial) {
   EXPECT_EQ(Factorial(Partition::Trivial()), 1);
   EXPECT_EQ(Factorial(Partition{5, 2, 1}), 240);
@@ -96,6 +179,18 @@ TEST(Partition, CycleTypeCount) {
   EXPECT_EQ(CycleTypeCount(Partition{1, 1, 1, 1, 1}), 1);
 }
 
+TEST(Partition, CycleTypeCountBeyondMachineWords) {
+  // The conjugacy classes partition the symmetric group, so their sizes sum to
+  // `n!`, which for these `n` no longer fits in 64 bits.
+  for (uint8_t n : {21, 25}) {
+    Integer total = 0;
+    for (Partition const &p : Partition::All(n)) { total += CycleTypeCount(p); }
+    EXPECT_EQ(total, Factorial(n));
+  }
+  EXPECT_EQ(CycleTypeCount(Partition::MaximallyDivided(30)), 1);
+  EXPECT_EQ(CycleTypeCount(Partition::Full(30)), Factorial(29));
+}
+
 TEST(Partition, FromComposition) {
   Partition p;
   bool sorted;
@@ -0,0 +1,430 @@
+#ifndef CHALK_FIXED_INTEGER_H
+#define CHALK_FIXED_INTEGER_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <utility>
+
+#include "chalk/algebra/property.h"
+#include "chalk/integer.h"
+
+namespace chalk {
+namespace internal_fixed_integer {
+
+// Returns the low and high limbs of the full product `a * b`. Unlike the
+// kernels backing `Integer`, this may be used in constant evaluation.
+constexpr std::pair<uint64_t, uint64_t> MultiplyLimbs(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  return {static_cast<uint64_t>(product),
+          static_cast<uint64_t>(product >> 64)};
+#else
+  constexpr uint64_t kLow = 0xffffffff;
+  uint64_t p00 = (a & kLow) * (b & kLow);
+  uint64_t p01 = (a & kLow) * (b >> 32);
+  uint64_t p10 = (a >> 32) * (b & kLow);
+  uint64_t p11 = (a >> 32) * (b >> 32);
+  uint64_t middle = (p00 >> 32) + (p01 & kLow) + (p10 & kLow);
+  return {(middle << 32) | (p00 & kLow),
+          p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32)};
+#endif
+}
+
+// Calls `f(0)`, `f(1)`, ..., `f(N - 1)` in order, with the loop unrolled.
+template <size_t N, typename F>
+constexpr void Unrolled(F &&f) {
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    (f(I), ...);
+  }(std::make_index_sequence<N>());
+}
+
+}  // namespace internal_fixed_integer
+
+// `FixedInteger<Bits>` is an integer whose magnitude is less than `2^Bits`,
+// for quantities with a known bound. It supports the same arithmetic and
+// comparisons as `Integer`, but stores its limbs inline and never allocates.
+// Each loop over limbs is unrolled, and every operation may be used in
+// constant evaluation.
+//
+// An operation whose result would not be representable is a precondition
+// violation, as with overflow of built-in signed integers, and is caught by an
+// assertion in debug builds. Where no bound is known, `CheckedAdd`,
+// `CheckedSubtract` and `CheckedMultiply` report such results instead, so that
+// the caller may fall back to `Integer`. Conversion to `Integer` is always
+// exact, and conversion from `Integer` reports values that are out of range.
+template <size_t Bits>
+struct FixedInteger {
+  static_assert(Bits > 0);
+  using chalk_properties = void(Ring, Commutative<'*'>);
+
+  // The number of limbs holding the magnitude.
+  static constexpr size_t kLimbs = (Bits + 63) / 64;
+
+  constexpr FixedInteger() = default;
+
+  constexpr FixedInteger(std::integral auto n) {
+    if constexpr (std::signed_integral<decltype(n)>) {
+      if (n < 0) {
+        negative_ = true;
+        limbs_[0] = uint64_t{0} - static_cast<uint64_t>(n);
+        assert(InRange(limbs_));
+        return;
+      }
+    }
+    limbs_[0] = static_cast<uint64_t>(n);
+    assert(InRange(limbs_));
+  }
+
+  // Values of a narrower `FixedInteger` are always representable.
+  template <size_t B>
+  constexpr FixedInteger(FixedInteger<B> const &n) requires(B < Bits)
+      : negative_(n.negative_) {
+    internal_fixed_integer::Unrolled<FixedInteger<B>::kLimbs>(
+        [&](size_t i) { limbs_[i] = n.limbs_[i]; });
+  }
+
+  // Returns `n` if it is representable, and `std::nullopt` otherwise.
+  static std::optional<FixedInteger> FromInteger(Integer const &n) {
+    if (n.size() > kLimbs) { return std::nullopt; }
+    FixedInteger result;
+    std::copy_n(n.limbs(), n.size(), result.limbs_.begin());
+    if (not InRange(result.limbs_)) { return std::nullopt; }
+    result.negative_ = Integer::IsNegative(n);
+    return result;
+  }
+
+  Integer ToInteger() const {
+    // Only the significant limbs are reserved, so that small values stay
+    // inline however wide the type is.
+    size_t size = kLimbs;
+    while (size > 0 and limbs_[size - 1] == 0) { --size; }
+    Integer result;
+    if (size == 0) { return result; }
+    result.EnsureCapacity(size);
+    std::copy_n(limbs_.begin(), size, result.limbs());
+    result.set_size(size);
+    if (negative_) { result.negate(); }
+    return result;
+  }
+
+  // Comparisons
+  friend constexpr bool operator==(FixedInteger const &lhs,
+                                   FixedInteger const &rhs) {
+    return lhs.negative_ == rhs.negative_ and
+           CompareMagnitudes(lhs.limbs_, rhs.limbs_) == 0;
+  }
+  friend constexpr bool operator!=(FixedInteger const &lhs,
+                                   FixedInteger const &rhs) {
+    return not(lhs == rhs);
+  }
+  friend constexpr bool operator<(FixedInteger const &lhs,
+                                  FixedInteger const &rhs) {
+    if (lhs.negative_ != rhs.negative_) { return lhs.negative_; }
+    int comparison = CompareMagnitudes(lhs.limbs_, rhs.limbs_);
+    return lhs.negative_ ? comparison > 0 : comparison < 0;
+  }
+  friend constexpr bool operator<=(FixedInteger const &lhs,
+                                   FixedInteger const &rhs) {
+    return not(rhs < lhs);
+  }
+  friend constexpr bool operator>(FixedInteger const &lhs,
+                                  FixedInteger const &rhs) {
+    return rhs < lhs;
+  }
+  friend constexpr bool operator>=(FixedInteger const &lhs,
+                                   FixedInteger const &rhs) {
+    return not(lhs < rhs);
+  }
+
+  // Addition and subtraction
+  constexpr FixedInteger &operator+=(FixedInteger const &rhs) {
+    [[maybe_unused]] bool representable = Add(rhs, rhs.negative_);
+    assert(representable);
+    return *this;
+  }
+  constexpr FixedInteger &operator-=(FixedInteger const &rhs) {
+    [[maybe_unused]] bool representable = Add(rhs, not rhs.negative_);
+    assert(representable);
+    return *this;
+  }
+  friend constexpr FixedInteger operator+(FixedInteger lhs,
+                                          FixedInteger const &rhs) {
+    return lhs += rhs;
+  }
+  friend constexpr FixedInteger operator-(FixedInteger lhs,
+                                          FixedInteger const &rhs) {
+    return lhs -= rhs;
+  }
+
+  // Negation
+  constexpr FixedInteger operator-() const {
+    FixedInteger result = *this;
+    result.negate();
+    return result;
+  }
+  constexpr void negate() {
+    if (not IsZero()) { negative_ = not negative_; }
+  }
+
+  // Multiplication. The full product is formed so that overflow is detected.
+  constexpr FixedInteger &operator*=(FixedInteger const &rhs) {
+    [[maybe_unused]] bool representable = Multiply(rhs);
+    assert(representable);
+    return *this;
+  }
+  friend constexpr FixedInteger operator*(FixedInteger lhs,
+                                          FixedInteger const &rhs) {
+    return lhs *= rhs;
+  }
+
+  // Multiplication by a machine word costs one pass over the limbs.
+  constexpr FixedInteger &operator*=(std::integral auto n) {
+    [[maybe_unused]] bool representable = MultiplyWord(n);
+    assert(representable);
+    return *this;
+  }
+
+  // Checked arithmetic, returning the result if it is representable and
+  // `std::nullopt` otherwise.
+  friend constexpr std::optional<FixedInteger> CheckedAdd(
+      FixedInteger lhs, FixedInteger const &rhs) {
+    if (not lhs.Add(rhs, rhs.negative_)) { return std::nullopt; }
+    return lhs;
+  }
+  friend constexpr std::optional<FixedInteger> CheckedSubtract(
+      FixedInteger lhs, FixedInteger const &rhs) {
+    if (not lhs.Add(rhs, not rhs.negative_)) { return std::nullopt; }
+    return lhs;
+  }
+  friend constexpr std::optional<FixedInteger> CheckedMultiply(
+      FixedInteger lhs, FixedInteger const &rhs) {
+    if (not lhs.Multiply(rhs)) { return std::nullopt; }
+    return lhs;
+  }
+  friend constexpr std::optional<FixedInteger> CheckedMultiply(
+      FixedInteger lhs, std::integral auto n) {
+    if (not lhs.MultiplyWord(n)) { return std::nullopt; }
+    return lhs;
+  }
+
+  // Division operations. As with `Integer`, quotients are truncated towards
+  // zero and remainders take the sign of the numerator. Each requires a
+  // non-zero denominator.
+  constexpr FixedInteger &operator/=(FixedInteger const &rhs) {
+    return *this = DivMod(*this, rhs).first;
+  }
+  constexpr FixedInteger &operator%=(FixedInteger const &rhs) {
+    return *this = DivMod(*this, rhs).second;
+  }
+  friend constexpr FixedInteger operator/(FixedInteger const &lhs,
+                                          FixedInteger const &rhs) {
+    return DivMod(lhs, rhs).first;
+  }
+  friend constexpr FixedInteger operator%(FixedInteger const &lhs,
+                                          FixedInteger const &rhs) {
+    return DivMod(lhs, rhs).second;
+  }
+
+  // Returns the quotient and remainder of `numerator / denominator`.
+  friend constexpr std::pair<FixedInteger, FixedInteger> DivMod(
+      FixedInteger const &numerator, FixedInteger const &denominator) {
+    assert(not denominator.IsZero());
+    std::pair<FixedInteger, FixedInteger> result;
+    DivideMagnitudes(numerator.limbs_, denominator.limbs_,
+                     result.first.limbs_, result.second.limbs_);
+    if (numerator.negative_ != denominator.negative_) { result.first.negate(); }
+    if (numerator.negative_) { result.second.negate(); }
+    return result;
+  }
+
+  friend std::ostream &operator<<(std::ostream &os, FixedInteger const &n) {
+    return os << n.ToInteger();
+  }
+
+ private:
+  template <size_t>
+  friend struct FixedInteger;
+
+  using Limbs = std::array<uint64_t, kLimbs>;
+
+  // Returns whether `a` is less than `2^Bits`.
+  static constexpr bool InRange(Limbs const &a) {
+    if constexpr (Bits % 64 == 0) {
+      return true;
+    } else {
+      return a[kLimbs - 1] >> (Bits % 64) == 0;
+    }
+  }
+
+  constexpr bool IsZero() const {
+    uint64_t bits = 0;
+    internal_fixed_integer::Unrolled<kLimbs>(
+        [&](size_t i) { bits |= limbs_[i]; });
+    return bits == 0;
+  }
+
+  // Returns a negative number, zero, or a positive number according to whether
+  // `a` is less than, equal to, or greater than `b`. Every limb is compared,
+  // with later (more significant) limbs taking precedence, so that the loop
+  // has no early exit.
+  static constexpr int CompareMagnitudes(Limbs const &a, Limbs const &b) {
+    int comparison = 0;
+    internal_fixed_integer::Unrolled<kLimbs>([&](size_t i) {
+      if (a[i] != b[i]) { comparison = a[i] < b[i] ? -1 : 1; }
+    });
+    return comparison;
+  }
+
+  // Sets `a` to `a + b` and returns the carry out of the top limb.
+  static constexpr uint64_t AddMagnitudes(Limbs &a, Limbs const &b) {
+    uint64_t carry = 0;
+    internal_fixed_integer::Unrolled<kLimbs>([&](size_t i) {
+      uint64_t sum    = a[i] + b[i];
+      uint64_t result = sum + carry;
+      carry           = (sum < b[i]) | (result < sum);
+      a[i]            = result;
+    });
+    return carry;
+  }
+
+  // Sets `a` to `a - b`, which requires `a >= b`.
+  static constexpr void SubtractMagnitudes(Limbs &a, Limbs const &b) {
+    uint64_t borrow = 0;
+    internal_fixed_integer::Unrolled<kLimbs>([&](size_t i) {
+      uint64_t limb       = a[i];
+      uint64_t difference = limb - b[i];
+      a[i]                = difference - borrow;
+      borrow              = (limb < b[i]) | (difference < borrow);
+    });
+    assert(borrow == 0);
+  }
+
+  // Adds the magnitude of `rhs` to `*this`, negated if `negative` is set, and
+  // returns true if the sum is representable, and otherwise returns false,
+  // leaving `*this` unspecified. `rhs` may alias `*this`.
+  constexpr bool Add(FixedInteger const &rhs, bool negative) {
+    if (negative_ == negative) {
+      if (AddMagnitudes(limbs_, rhs.limbs_) != 0 or not InRange(limbs_)) {
+        return false;
+      }
+    } else if (CompareMagnitudes(limbs_, rhs.limbs_) >= 0) {
+      SubtractMagnitudes(limbs_, rhs.limbs_);
+    } else {
+      Limbs difference = rhs.limbs_;
+      SubtractMagnitudes(difference, limbs_);
+      limbs_    = difference;
+      negative_ = negative;
+    }
+    if (IsZero()) { negative_ = false; }
+    return true;
+  }
+
+  // Sets `*this` to `*this * rhs` and returns true if the product is
+  // representable, and otherwise returns false, leaving `*this` unspecified.
+  // `rhs` may alias `*this`.
+  constexpr bool Multiply(FixedInteger const &rhs) {
+    std::array<uint64_t, 2 * kLimbs> product{};
+    internal_fixed_integer::Unrolled<kLimbs>([&](size_t i) {
+      uint64_t carry = 0;
+      internal_fixed_integer::Unrolled<kLimbs>([&](size_t j) {
+        auto [low, high] =
+            internal_fixed_integer::MultiplyLimbs(limbs_[i], rhs.limbs_[j]);
+        low += carry;
+        high += low < carry;
+        uint64_t sum    = product[i + j] + low;
+        carry           = high + (sum < low);
+        product[i + j] = sum;
+      });
+      product[i + kLimbs] = carry;
+    });
+    uint64_t high = 0;
+    internal_fixed_integer::Unrolled<kLimbs>([&](size_t i) {
+      high |= product[kLimbs + i];
+      limbs_[i] = product[i];
+    });
+    negative_ = negative_ != rhs.negative_ and not IsZero();
+    return high == 0 and InRange(limbs_);
+  }
+
+  // As `Multiply`, for a machine word `n`.
+  constexpr bool MultiplyWord(std::integral auto n) {
+    uint64_t magnitude = static_cast<uint64_t>(n);
+    if constexpr (std::signed_integral<decltype(n)>) {
+      if (n < 0) {
+        magnitude = uint64_t{0} - magnitude;
+        negate();
+      }
+    }
+    uint64_t carry = 0;
+    internal_fixed_integer::Unrolled<kLimbs>([&](size_t i) {
+      auto [low, high] =
+          internal_fixed_integer::MultiplyLimbs(limbs_[i], magnitude);
+      low += carry;
+      carry     = high + (low < carry);
+      limbs_[i] = low;
+    });
+    if (IsZero()) { negative_ = false; }
+    return carry == 0 and InRange(limbs_);
+  }
+
+  // Sets `q` and `r` to the quotient and remainder of `a / b`, which requires
+  // `b` to be non-zero. Single-limb divisors divide a limb at a time where the
+  // compiler provides 128-bit division; otherwise the quotient is formed a bit
+  // at a time.
+  static constexpr void DivideMagnitudes(Limbs const &a, Limbs const &b,
+                                         Limbs &q, Limbs &r) {
+    q = Limbs{};
+    r = Limbs{};
+#if defined(__SIZEOF_INT128__)
+    uint64_t high = 0;
+    internal_fixed_integer::Unrolled<kLimbs - 1>(
+        [&](size_t i) { high |= b[i + 1]; });
+    if (high == 0) {
+      unsigned __int128 remainder = 0;
+      internal_fixed_integer::Unrolled<kLimbs>([&](size_t i) {
+        size_t limb = kLimbs - 1 - i;
+        remainder   = (remainder << 64) | a[limb];
+        q[limb]     = static_cast<uint64_t>(remainder / b[0]);
+        remainder %= b[0];
+      });
+      r[0] = static_cast<uint64_t>(remainder);
+      return;
+    }
+#endif
+    for (size_t bit = Bits; bit-- > 0;) {
+      // The remainder is less than `b`, so doubling it may carry out of the
+      // top limb only if `Bits` is a multiple of 64.
+      uint64_t top = r[kLimbs - 1] >> 63;
+      internal_fixed_integer::Unrolled<kLimbs>([&](size_t i) {
+        size_t limb = kLimbs - 1 - i;
+        r[limb]     = (r[limb] << 1) | (limb == 0 ? 0 : r[limb - 1] >> 63);
+      });
+      r[0] |= (a[bit / 64] >> (bit % 64)) & 1;
+      if (top != 0 or CompareMagnitudes(r, b) >= 0) {
+        // Any carry out of the top limb is cancelled by the wrap-around of the
+        // subtraction, so the borrow is discarded.
+        uint64_t borrow = 0;
+        internal_fixed_integer::Unrolled<kLimbs>([&](size_t i) {
+          uint64_t limb       = r[i];
+          uint64_t difference = limb - b[i];
+          r[i]                = difference - borrow;
+          borrow              = (limb < b[i]) | (difference < borrow);
+        });
+        q[bit / 64] |= uint64_t{1} << (bit % 64);
+      }
+    }
+  }
+
+  Limbs limbs_{};
+  bool negative_ = false;
+};
+
+}  // namespace chalk
+
+#endif  // CHALK_FIXED_INTEGER_H
@@ -0,0 +1,152 @@
+#include "chalk/fixed_integer.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "chalk/algebra/dense_polynomial.h"
+#include "chalk/integer.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk {
+namespace {
+
+using ::testing::ElementsAre;
+
+static_assert(Satisfies<FixedInteger<64>, Ring>);
+static_assert(Satisfies<FixedInteger<200>, Commutative<'*'>>);
+static_assert(sizeof(FixedInteger<128>) <= 3 * sizeof(uint64_t));
+
+// Returns `n!` in constant evaluation.
+template <size_t Bits>
+constexpr FixedInteger<Bits> ConstantFactorial(int n) {
+  FixedInteger<Bits> result = 1;
+  for (int i = 2; i <= n; ++i) { result *= i; }
+  return result;
+}
+
+static_assert(ConstantFactorial<64>(20) == 2432902008176640000);
+static_assert(ConstantFactorial<200>(40) / ConstantFactorial<200>(38) ==
+              40 * 39);
+static_assert(ConstantFactorial<200>(40) % 41 == 40);
+static_assert(-FixedInteger<100>(7) < 3);
+static_assert(FixedInteger<100>(7) - 10 == -3);
+static_assert(FixedInteger<100>(-7) / 2 == -3);
+static_assert(FixedInteger<100>(-7) % 2 == -1);
+static_assert((FixedInteger<100>(7) *= -3) == -21);
+static_assert((FixedInteger<100>(-7) *= 0) == 0);
+static_assert(CheckedAdd(FixedInteger<4>(7), FixedInteger<4>(8)) == 15);
+static_assert(not CheckedAdd(FixedInteger<4>(8), FixedInteger<4>(8)));
+
+template <size_t Bits>
+std::string ToString(FixedInteger<Bits> const &n) {
+  std::stringstream ss;
+  ss << n;
+  return ss.str();
+}
+
+TEST(FixedInteger, Construction) {
+  EXPECT_EQ(FixedInteger<64>(), 0);
+  EXPECT_EQ(FixedInteger<64>(-5), -5);
+  EXPECT_EQ(FixedInteger<64>(~uint64_t{0}).ToInteger(), ~uint64_t{0});
+  EXPECT_EQ(FixedInteger<64>(int64_t{-1} << 63).ToInteger(),
+            int64_t{-1} << 63);
+  EXPECT_EQ(FixedInteger<200>(FixedInteger<64>(-9)), -9);
+  EXPECT_EQ(ToString(ConstantFactorial<200>(40)),
+            "815915283247897734345611269596115894272000000000");
+}
+
+TEST(FixedInteger, FromInteger) {
+  Integer factorial = 1;
+  for (int i = 2; i <= 34; ++i) { factorial *= i; }
+  // 34! lies between 2^127 and 2^128.
+  EXPECT_EQ(FixedInteger<128>::FromInteger(factorial)->ToInteger(), factorial);
+  EXPECT_EQ(FixedInteger<128>::FromInteger(-factorial)->ToInteger(),
+            -factorial);
+  EXPECT_EQ(FixedInteger<127>::FromInteger(factorial), std::nullopt);
+  EXPECT_EQ(FixedInteger<64>::FromInteger(factorial), std::nullopt);
+  EXPECT_EQ(FixedInteger<64>::FromInteger(Integer(-3)), -3);
+}
+
+TEST(FixedInteger, MatchesInteger) {
+  std::mt19937_64 gen(0);
+  auto random = [&](int limbs) {
+    Integer result = 0;
+    for (int i = 0; i < limbs; ++i) {
+      result *= Integer(uint64_t{1} << 32) * Integer(uint64_t{1} << 32);
+      result += gen() >> (gen() % 64);
+    }
+    if (gen() % 2) { result = -result; }
+    return result;
+  };
+  using F = FixedInteger<256>;
+  for (int trial = 0; trial < 200; ++trial) {
+    Integer a = random(2);
+    Integer b = random(1 + trial % 2);
+    F fa      = *F::FromInteger(a);
+    F fb      = *F::FromInteger(b);
+    EXPECT_EQ((fa + fb).ToInteger(), a + b);
+    EXPECT_EQ((fa - fb).ToInteger(), a - b);
+    EXPECT_EQ((fb - fa).ToInteger(), b - a);
+    EXPECT_EQ((fa * fb).ToInteger(), a * b);
+    EXPECT_EQ(fa < fb, a < b);
+    EXPECT_EQ(fa == fb, a == b);
+    if (b != 0) {
+      EXPECT_EQ((fa / fb).ToInteger(), a / b);
+      EXPECT_EQ((fa % fb).ToInteger(), a % b);
+    }
+  }
+}
+
+TEST(FixedInteger, Aliasing) {
+  FixedInteger<128> n = -12345678901234;
+  n *= n;
+  EXPECT_EQ(n.ToInteger(), Integer(12345678901234) * 12345678901234);
+  n += n;
+  n -= n;
+  EXPECT_EQ(n, 0);
+}
+
+TEST(FixedInteger, CheckedArithmetic) {
+  using F = FixedInteger<128>;
+  F max   = *F::FromInteger(Integer(~uint64_t{0}) * Integer(~uint64_t{0}) +
+                            Integer(~uint64_t{0}) * 2);
+  EXPECT_EQ(CheckedAdd(max, F(-1)), max - 1);
+  EXPECT_EQ(CheckedAdd(max, F(1)), std::nullopt);
+  EXPECT_EQ(CheckedAdd(-max, F(-1)), std::nullopt);
+  EXPECT_EQ(CheckedSubtract(-max, F(1)), std::nullopt);
+  EXPECT_EQ(CheckedSubtract(max, max), 0);
+
+  F half = *F::FromInteger(Integer(uint64_t{1} << 63) *
+                           Integer(uint64_t{1} << 1));
+  EXPECT_EQ(CheckedMultiply(half, half), std::nullopt);
+  EXPECT_EQ(CheckedMultiply(half, F(-3)), -3 * half);
+  EXPECT_EQ(CheckedMultiply(max, 1), max);
+  EXPECT_EQ(CheckedMultiply(max, -2), std::nullopt);
+  EXPECT_EQ(CheckedMultiply(F(uint64_t{1} << 63), F(uint64_t{1} << 63))
+                ->ToInteger(),
+            Integer(uint64_t{1} << 63) * Integer(uint64_t{1} << 63));
+  // Overflow of a type narrower than its limbs is caught as well.
+  EXPECT_EQ(CheckedMultiply(FixedInteger<100>(uint64_t{1} << 50),
+                            FixedInteger<100>(uint64_t{1} << 50)),
+            std::nullopt);
+}
+
+TEST(FixedInteger, Coefficients) {
+  // The coefficients of `(x + c)^2` span both limbs, with the constant term
+  // just below `2^128`.
+  using F               = FixedInteger<128>;
+  using polynomial_type = DensePolynomial<F>;
+  Integer c             = ~uint64_t{0};
+  F square              = *F::FromInteger(c * c);
+  polynomial_type x     = polynomial_type::FromCoefficients({0, 1});
+  polynomial_type p     = x + F(~uint64_t{0});
+  EXPECT_THAT((p * p).coefficients(),
+              ElementsAre(square, *F::FromInteger(2 * c), 1));
+  EXPECT_THAT((p * (x - F(~uint64_t{0}))).coefficients(),
+              ElementsAre(-square, 0, 1));
+}
+
+}  // namespace
+}  // namespace chalk
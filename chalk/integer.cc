@@ -1,62 +1,210 @@
 #include "integer.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "absl/numeric/int128.h"
-#include "absl/strings/str_format.h"
+#include "chalk/integer_executor.h"
+#include "chalk/internal/divide.h"
+#include "chalk/internal/gcd.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/multiply.h"
+#include "chalk/internal/power.h"
+#include "chalk/internal/radix.h"
+#include "chalk/limb_allocator.h"
 
 namespace chalk {
 namespace {
 
-[[maybe_unused]] std::pair<uint64_t, uint64_t> Subtract(uint64_t l,
-                                                        uint64_t r) {
-  return std::make_pair(l - r, r > l ? 1 : 0);
+// Heap-allocated limbs are preceded by a pointer to the allocator they came
+// from, so that they are returned to it regardless of which allocator is
+// current when they are released. Allocates room for at least `capacity` limbs
+// and raises `capacity` so that, with the pointer, it fills the block the
+// default allocator reserves.
+uint64_t *AllocateLimbs(size_t &capacity) {
+  capacity                 = LimbBlockSize(capacity + 1) - 1;
+  LimbAllocator &allocator = CurrentLimbAllocator();
+  uint64_t *block          = allocator.Allocate(capacity + 1);
+  block[0]                 = reinterpret_cast<uintptr_t>(&allocator);
+  return block + 1;
 }
 
-[[maybe_unused]] std::pair<uint64_t, uint64_t> Add(uint64_t l, uint64_t r) {
-  return std::make_pair(l + r, l + r < l ? 1 : 0);
+void DeallocateLimbs(uint64_t *ptr, size_t n) {
+  uint64_t *block = ptr - 1;
+  reinterpret_cast<LimbAllocator *>(block[0])->Deallocate(block, n + 1);
 }
 
-std::pair<uint64_t, uint64_t> Multiply(uint64_t l, uint64_t r) {
-  absl::uint128 result = l;
-  result *= r;
-  return std::make_pair(absl::Uint128Low64(result),
-                        absl::Uint128High64(result));
+// Subtrees of a product holding at least this many limbs are worth running as
+// tasks of their own.
+constexpr size_t kParallelProductLimbs = 4096;
+
+// Products of machine words are formed one word at a time up to leaves of this
+// many limbs, below which the tree would gain nothing over schoolbook
+// multiplication.
+constexpr size_t kProductLeafLimbs = 16;
+
+// Returns the product of the non-empty range `factors[first, last)`, where
+// `limbs[i]` is the total number of limbs in `factors[0, i)`. The range is
+// split where its limbs divide most evenly, and the halves of large ranges are
+// multiplied as concurrent tasks on `executor`.
+Integer ProductTree(absl::Span<Integer const> factors,
+                    absl::Span<size_t const> limbs, size_t first, size_t last,
+                    IntegerExecutor &executor) {
+  if (last - first == 1) { return factors[first]; }
+  size_t target = limbs[first] + (limbs[last] - limbs[first]) / 2;
+  size_t middle =
+      std::lower_bound(limbs.begin() + first + 1, limbs.begin() + last - 1,
+                       target) -
+      limbs.begin();
+  if (middle > first + 1 and limbs[middle] > target and
+      target - limbs[middle - 1] < limbs[middle] - target) {
+    --middle;
+  }
+
+  if (executor.concurrency() > 1 and
+      limbs[last] - limbs[first] >= kParallelProductLimbs) {
+    std::array<Integer, 2> halves;
+    executor.Run(2, [&](size_t i) {
+      // Tasks may run on threads whose current executor is serial, so the
+      // products within each half are routed back to `executor`.
+      ScopedIntegerExecutor scope(executor);
+      halves[i] = i == 0 ? ProductTree(factors, limbs, first, middle, executor)
+                         : ProductTree(factors, limbs, middle, last, executor);
+    });
+    return halves[0] * halves[1];
+  }
+  return ProductTree(factors, limbs, first, middle, executor) *
+         ProductTree(factors, limbs, middle, last, executor);
 }
 
-}  // namespace
+// Produces the limbs of the two's-complement representation of the value with
+// magnitude `limbs[0, size)` and the given sign, from least to most
+// significant, followed by its infinitely many sign-extension limbs. The
+// two's complement of a magnitude `m` is `~(m - 1)`, where the borrow out of
+// each limb propagates only through limbs that are zero.
+struct TwosComplementReader {
+  uint64_t Next() {
+    uint64_t limb = index < size ? limbs[index] : 0;
+    ++index;
+    if (not negative) { return limb; }
+    uint64_t result = ~(limb - borrow);
+    borrow &= static_cast<uint64_t>(limb == 0);
+    return result;
+  }
+
+  uint64_t const *limbs;
+  size_t size;
+  bool negative;
+  size_t index    = 0;
+  uint64_t borrow = 1;
+};
+
+// Sets `r[0, n + 1)` to the magnitude of the result of applying `op` to the
+// two's-complement representations of `a` and `b`, whose sign is `negative`.
+// Both operands fit in `n` limbs, so their sign-extension limbs, and hence
+// those of the result, are constant beyond them. A negative result `t` has
+// magnitude `~t + 1`, which may carry into limb `n`. `r` may be `a.limbs`.
+template <typename Op>
+void BitwiseLimbs(uint64_t *r, TwosComplementReader a, TwosComplementReader b,
+                  size_t n, bool negative, Op op) {
+  if (not a.negative and not b.negative) {
+    size_t common = std::min(a.size, b.size);
+    for (size_t i = 0; i < common; ++i) { r[i] = op(a.limbs[i], b.limbs[i]); }
+    for (size_t i = common; i < n; ++i) {
+      r[i] = op(i < a.size ? a.limbs[i] : 0, i < b.size ? b.limbs[i] : 0);
+    }
+    r[n] = 0;
+    return;
+  }
+  uint64_t carry = 1;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t limb = op(a.Next(), b.Next());
+    if (negative) {
+      limb = ~limb + carry;
+      carry &= static_cast<uint64_t>(limb == 0);
+    }
+    r[i] = limb;
+  }
+  r[n] = negative ? carry : 0;
+}
 
-Integer::Integer(uint64_t n)
-    : data_{reinterpret_cast<uintptr_t>(new uint64_t[1]), 1, 1} {
-  span()[0] = n;
+// Returns limb `i` of the two's-complement representation of `n`.
+uint64_t TwosComplementLimb(absl::Span<uint64_t const> n, bool negative,
+                            size_t i) {
+  uint64_t limb = i < n.size() ? n[i] : 0;
+  if (not negative) { return limb; }
+  // The borrow reaches limb `i` only if every lower limb is zero.
+  bool borrow = std::all_of(n.begin(), n.begin() + std::min(i, n.size()),
+                            [](uint64_t l) { return l == 0; });
+  return ~(limb - borrow);
 }
 
+}  // namespace
+
+Integer::Integer(uint64_t n) : data_{n, 0, uint64_t{1} << kMetadataBits} {}
+
 Integer::Integer(Integer const &n) {
-  uint64_t *ptr = new uint64_t[n.data_[1]];
-  data_[1]      = n.data_[1];
-  data_[2]      = n.data_[1];
-  std::memcpy(ptr, n.span().data(), span().size() * sizeof(uint64_t));
-  data_[0] = reinterpret_cast<uintptr_t>(ptr) | (n.data_[0] & 1);
+  size_t size = n.size();
+  if (size <= kInlineCapacity) {
+    data_[0] = n.limbs()[0];
+    data_[1] = size > 1 ? n.limbs()[1] : 0;
+    data_[2] = (n.data_[2] & kSignBit) | (size << kMetadataBits);
+  } else {
+    size_t capacity = size;
+    uint64_t *ptr   = AllocateLimbs(capacity);
+    std::memcpy(ptr, n.limbs(), size * sizeof(uint64_t));
+    data_[0] = reinterpret_cast<uintptr_t>(ptr);
+    data_[1] = size;
+    data_[2] =
+        (n.data_[2] & kSignBit) | kHeapBit | (capacity << kMetadataBits);
+  }
 }
 
 Integer::Integer(Integer &&n) {
-  std::memcpy(data_, n.data_, sizeof(uintptr_t) * 3);
-  std::memset(n.data_, 0, sizeof(uintptr_t) * 3);
+  std::memcpy(data_, n.data_, sizeof(data_));
+  n.data_[0] = 0;
+  n.data_[1] = 0;
+  n.data_[2] = uint64_t{1} << kMetadataBits;
 }
 
 Integer &Integer::operator=(Integer const &n) {
-  this->~Integer();
-  new (this) Integer(n);
+  if (this == &n) { return *this; }
+  size_t size = n.size();
+  if (capacity() < size) {
+    this->~Integer();
+    new (this) Integer(n);
+  } else {
+    std::memcpy(limbs(), n.limbs(), size * sizeof(uint64_t));
+    set_size(size);
+    data_[2] = (data_[2] & ~kSignBit) | (n.data_[2] & kSignBit);
+  }
   return *this;
 }
 
 Integer &Integer::operator=(Integer &&n) {
-  std::memcpy(data_, n.data_, sizeof(uintptr_t) * 3);
-  std::memset(n.data_, 0, sizeof(uintptr_t) * 3);
+  if (this == &n) { return *this; }
+  if (not is_inline()) { DeallocateLimbs(limbs(), capacity()); }
+  std::memcpy(data_, n.data_, sizeof(data_));
+  n.data_[0] = 0;
+  n.data_[1] = 0;
+  n.data_[2] = uint64_t{1} << kMetadataBits;
   return *this;
 }
 
-Integer::~Integer() { delete[] span().data(); }
+Integer::~Integer() {
+  if (not is_inline()) { DeallocateLimbs(limbs(), capacity()); }
+}
+
+void Integer::Reset() {
+  this->~Integer();
+  new (this) Integer();
+}
 
 Integer Integer::operator-() & {
   Integer result = *this;
@@ -74,129 +222,384 @@ Integer Integer::operator-() && {
   return std::move(*this);
 }
 
-Integer &Integer::SignSafeAddition(Integer const &rhs, uintptr_t offset) {
-  EnsureCapacity(std::max(span().size(), rhs.span().size() + offset) + 1);
-  auto lhs_iter = std::next(span().begin(), offset);
-  auto rhs_end  = rhs.span().end();
-
-  bool carry = false;
-  for (auto rhs_iter = rhs.span().begin(); rhs_iter != rhs_end;
-       ++lhs_iter, ++rhs_iter) {
-    uintptr_t previous_value = *lhs_iter;
-    *lhs_iter += *rhs_iter + (carry ? 1 : 0);
-    carry = (previous_value > *lhs_iter);
+Integer &Integer::SignSafeAddition(Integer const &rhs) {
+  size_t size     = this->size();
+  size_t rhs_size = rhs.size();
+  EnsureCapacity(std::max(size, rhs_size) + 1);
+  // `rhs` may alias `*this`, so its limbs are only read after any reallocation.
+  uint64_t *words           = limbs();
+  uint64_t const *rhs_words = rhs.limbs();
+  if (size >= rhs_size) {
+    words[size] =
+        internal_integer::Add(words, words, size, rhs_words, rhs_size);
+  } else {
+    words[rhs_size] =
+        internal_integer::Add(words, rhs_words, rhs_size, words, size);
+    size = rhs_size;
   }
-  if (lhs_iter == span().end()) { IncrementSize(); }
-  if (carry) { ++*lhs_iter; }
+  set_size(size + 1);
   ShrinkToFit();
   return *this;
 }
 
-Integer &Integer::SignSafeSubtraction(Integer const &rhs, uintptr_t offset) {
-  EnsureCapacity(std::max(span().size(), rhs.span().size() + offset) + 1);
-  auto lhs_iter = std::next(span().begin(), offset);
-  auto rhs_end  = rhs.span().end();
-  bool carry = false;
-  for (auto rhs_iter = rhs.span().begin(); rhs_iter != rhs_end;
-       ++lhs_iter, ++rhs_iter) {
-    uintptr_t previous_value = *lhs_iter;
-    *lhs_iter -= *rhs_iter + (carry ? 1 : 0);
-    carry = (previous_value < *rhs_iter);
+Integer &Integer::SignSafeSubtraction(Integer const &rhs) {
+  size_t size     = this->size();
+  size_t rhs_size = rhs.size();
+  if (MagnitudeLess(*this, rhs)) {
+    EnsureCapacity(rhs_size);
+    uint64_t *words = limbs();
+    internal_integer::Sub(words, rhs.limbs(), rhs_size, words, size);
+    set_size(rhs_size);
+    negate();
+  } else {
+    uint64_t *words = limbs();
+    internal_integer::Sub(words, words, size, rhs.limbs(), rhs_size);
   }
-  if (carry) { --*lhs_iter; }
   ShrinkToFit();
   return *this;
 }
 
 Integer &Integer::operator+=(Integer const &rhs) {
-  if (IsNegative(*this)) {
-    negate();
-    *this -= rhs;
-    if (not IsZero()) { negate(); }
-  } else {
-    if (IsNegative(rhs)) {
-      if (MagnitudeLess(*this, rhs)) {
-        Integer result = rhs;
-        result.SignSafeSubtraction(*this, 0);
-        *this = std::move(result);
+  if (IsNegative(*this) == IsNegative(rhs)) { return SignSafeAddition(rhs); }
+  return SignSafeSubtraction(rhs);
+}
+
+Integer &Integer::operator-=(Integer const &rhs) {
+  if (IsNegative(*this) != IsNegative(rhs)) { return SignSafeAddition(rhs); }
+  return SignSafeSubtraction(rhs);
+}
+
+Integer &Integer::MultiplyAccumulate(Integer const &a, uint64_t const *b,
+                                     size_t bn, bool negative_product) {
+  uint64_t const *a_limbs = a.limbs();
+  size_t an               = a.size();
+  if (an < bn) {
+    std::swap(a_limbs, b);
+    std::swap(an, bn);
+  }
+
+  // Accumulate into enough limbs to hold any sum. A difference which would be
+  // negative instead wraps around modulo `2^(64 * n)`, which is detected by a
+  // borrow out of the top limb and undone below.
+  bool subtract = negative_product != IsNegative(*this);
+  size_t size   = this->size();
+  size_t n      = std::max(size, an + bn) + 1;
+  EnsureCapacity(n);
+  uint64_t *r = limbs();
+  std::fill(r + size, r + n, 0);
+
+  uint64_t wrapped = 0;
+  if (bn < GlobalIntegerThresholds().karatsuba_multiplication) {
+    for (size_t i = 0; i < bn; ++i) {
+      uint64_t *row = r + i;
+      if (subtract) {
+        uint64_t borrow = internal_integer::SubMulOne(row, a_limbs, an, b[i]);
+        wrapped |= internal_integer::SubOne(row + an, row + an, n - an - i,
+                                            borrow);
       } else {
-        SignSafeSubtraction(rhs, 0);
+        uint64_t carry = internal_integer::AddMulOne(row, a_limbs, an, b[i]);
+        internal_integer::AddOne(row + an, row + an, n - an - i, carry);
       }
+    }
+  } else {
+    std::vector<uint64_t> product(an + bn);
+    internal_integer::Multiply(product.data(), a_limbs, an, b, bn);
+    if (subtract) {
+      wrapped = internal_integer::Sub(r, r, n, product.data(), an + bn);
     } else {
-      SignSafeAddition(rhs, 0);
+      internal_integer::Add(r, r, n, product.data(), an + bn);
     }
   }
-  return *this;
-}
 
-Integer &Integer::operator-=(Integer const &rhs) {
-  if (IsNegative(*this)) {
+  set_size(n);
+  if (wrapped) {
+    for (size_t i = 0; i < n; ++i) { r[i] = ~r[i]; }
+    internal_integer::AddOne(r, r, n, 1);
     negate();
-    *this += rhs;
-    if (not IsZero()) { negate(); }
-  } else {
-    if (IsNegative(rhs)) {
-      SignSafeAddition(rhs, 0);
-    } else {
-      if (MagnitudeLess(*this, rhs)) {
-        Integer result = rhs;
-        result.SignSafeSubtraction(*this, 0);
-        *this = std::move(result);
-        negate();
-      } else {
-        SignSafeSubtraction(rhs, 0);
-      }
-    }
   }
+  ShrinkToFit();
   return *this;
 }
 
-Integer operator*(Integer const &lhs, Integer const &rhs) {
-  Integer result;
-  result.EnsureCapacity(lhs.span().size() + rhs.span().size());
-  for (auto lhs_iter = lhs.span().begin(); lhs_iter != lhs.span().end();
-       ++lhs_iter) {
-    result.SignSafeAddition(*lhs_iter * rhs,
-                            std::distance(lhs.span().begin(), lhs_iter));
+Integer &Integer::AddMulWord(Integer const &a, uint64_t b,
+                             bool negative_product) {
+  if (b == 0) { return *this; }
+  if (&a == this) {
+    Integer copy = a;
+    return MultiplyAccumulate(copy, &b, 1, negative_product);
   }
+  return MultiplyAccumulate(a, &b, 1, negative_product);
+}
+
+Integer &Integer::AddMul(Integer const &a, Integer const &b) {
+  if (&a == this or &b == this) { return *this += a * b; }
+  return MultiplyAccumulate(a, b.limbs(), b.size(),
+                            IsNegative(a) != IsNegative(b));
+}
 
+Integer &Integer::SubMul(Integer const &a, Integer const &b) {
+  if (&a == this or &b == this) { return *this -= a * b; }
+  return MultiplyAccumulate(a, b.limbs(), b.size(),
+                            IsNegative(a) == IsNegative(b));
+}
+
+Integer operator*(Integer const &lhs, Integer const &rhs) {
+  if (&lhs == &rhs) { return lhs.Square(); }
+  size_t lhs_size = lhs.size();
+  size_t rhs_size = rhs.size();
+  Integer result;
+  result.EnsureCapacity(lhs_size + rhs_size);
+  internal_integer::Multiply(result.limbs(), lhs.limbs(), lhs_size,
+                             rhs.limbs(), rhs_size);
+  result.set_size(lhs_size + rhs_size);
   if (Integer::IsNegative(lhs) != Integer::IsNegative(rhs)) { result.negate(); }
   result.ShrinkToFit();
   return result;
 }
 
-void Integer::MultiplyBy(uint64_t n) {
-  EnsureCapacity(span().size() + 1);
-  uint64_t carry = 0;
-  for (uint64_t &word : span()) {
-    uint64_t previous_carry = carry;
-    std::tie(word, carry)   = Multiply(n, word);
-    word += previous_carry;
+Integer Integer::Square() const {
+  size_t n = size();
+  Integer result;
+  result.EnsureCapacity(2 * n);
+  internal_integer::Square(result.limbs(), limbs(), n);
+  result.set_size(2 * n);
+  result.ShrinkToFit();
+  return result;
+}
+
+Integer Pow(Integer const &base, uint64_t exponent) {
+  size_t n    = base.size();
+  size_t size = internal_integer::PowSize(base.limbs(), n, exponent);
+  Integer result;
+  result.EnsureCapacity(size);
+  internal_integer::Pow(result.limbs(), base.limbs(), n, exponent);
+  result.set_size(size);
+  result.ShrinkToFit();
+  if (Integer::IsNegative(base) and exponent % 2 == 1) { result.negate(); }
+  return result;
+}
+
+Integer ProductOf(absl::Span<Integer const> factors) {
+  if (factors.empty()) { return 1; }
+  std::vector<size_t> limbs(factors.size() + 1, 0);
+  for (size_t i = 0; i < factors.size(); ++i) {
+    limbs[i + 1] = limbs[i] + factors[i].size();
+  }
+  return ProductTree(factors, limbs, 0, factors.size(),
+                     CurrentIntegerExecutor());
+}
+
+Integer ProductOf(absl::Span<uint64_t const> factors) {
+  std::vector<Integer> leaves;
+  Integer leaf  = 1;
+  uint64_t word = 1;
+  for (uint64_t factor : factors) {
+    if (factor == 0) { return 0; }
+    absl::uint128 product = absl::uint128(word) * factor;
+    if (absl::Uint128High64(product) == 0) {
+      word = absl::Uint128Low64(product);
+      continue;
+    }
+    leaf.MultiplyBy(word);
+    word = factor;
+    if (leaf.size() == kProductLeafLimbs) {
+      leaves.push_back(std::move(leaf));
+      leaf = 1;
+    }
   }
-  if (carry) {
-    IncrementSize();
-    span().back() = carry;
+  leaf.MultiplyBy(word);
+  leaves.push_back(std::move(leaf));
+  return ProductOf(leaves);
+}
+
+void Integer::MultiplyBy(uint64_t n) {
+  size_t size     = this->size();
+  uint64_t *words = limbs();
+  uint64_t carry  = internal_integer::MulOne(words, words, size, n);
+  if (carry != 0) {
+    EnsureCapacity(size + 1);
+    limbs()[size] = carry;
+    set_size(size + 1);
+  } else if (n == 0) {
+    ShrinkToFit();
   }
+}
+
+uint64_t Integer::DivideByWord(uint64_t n) {
+  assert(n != 0);
+  uint64_t *words = limbs();
+  uint64_t remainder = internal_integer::DivRemOne(words, words, size(), n);
   ShrinkToFit();
+  return remainder;
+}
+
+Integer Integer::WordProduct(Integer const &n, uint64_t m) {
+  size_t size = n.size();
+  if (size <= kInlineCapacity) {
+    // Copying is free, and multiplying in place allocates only if the product
+    // outgrows the inline storage.
+    Integer result = n;
+    result.MultiplyBy(m);
+    return result;
+  }
+  // Write the product directly rather than copying `n` and multiplying in
+  // place.
+  Integer result;
+  result.EnsureCapacity(size + 1);
+  uint64_t *words = result.limbs();
+  words[size]     = internal_integer::MulOne(words, n.limbs(), size, m);
+  result.set_size(size + 1);
+  if (IsNegative(n)) { result.negate(); }
+  result.ShrinkToFit();
+  return result;
+}
+
+Integer Integer::ExactWordQuotient(Integer const &n, uint64_t m) {
+  assert(m != 0);
+  size_t size = n.size();
+  Integer result;
+  result.EnsureCapacity(size);
+  internal_integer::DivExactOne(result.limbs(), n.limbs(), size, m);
+  result.set_size(size);
+  if (IsNegative(n)) { result.negate(); }
+  result.ShrinkToFit();
+  return result;
+}
+
+Integer Integer::WordRemainder(Integer const &n, uint64_t m) {
+  assert(m != 0);
+  return Integer(internal_integer::RemOne(n.limbs(), n.size(), m));
+}
+
+Integer &Integer::AddWord(uint64_t magnitude, bool negative) {
+  size_t size     = this->size();
+  uint64_t *words = limbs();
+  if (IsNegative(*this) == negative) {
+    uint64_t carry = internal_integer::AddOne(words, words, size, magnitude);
+    if (carry != 0) {
+      EnsureCapacity(size + 1);
+      limbs()[size] = carry;
+      set_size(size + 1);
+    }
+  } else if (size > 1) {
+    // The magnitude of `*this` exceeds that of any word, so the sign is
+    // unchanged.
+    internal_integer::SubOne(words, words, size, magnitude);
+    ShrinkToFit();
+  } else if (words[0] >= magnitude) {
+    words[0] -= magnitude;
+    ShrinkToFit();
+  } else {
+    words[0] = magnitude - words[0];
+    negate();
+  }
+  return *this;
+}
+
+size_t MaxChars(Integer const &n, int base) {
+  assert(base == 10 or base == 16);
+  size_t digits = base == 16 ? 16 * n.size()
+                             : internal_integer::DecimalDigitsBound(n.size());
+  return digits + Integer::IsNegative(n);
+}
+
+std::to_chars_result ToChars(char *first, char *last, Integer const &n,
+                             int base) {
+  assert(base == 10 or base == 16);
+  size_t bound = MaxChars(n, base);
+  if (static_cast<size_t>(last - first) < bound) {
+    // The exact length is not known until the digits have been computed, so
+    // write them to a buffer that is certainly large enough.
+    std::string buffer(bound, '\0');
+    auto [end, error] = ToChars(buffer.data(), buffer.data() + bound, n, base);
+    size_t length     = end - buffer.data();
+    if (length > static_cast<size_t>(last - first)) {
+      return {last, std::errc::value_too_large};
+    }
+    return {std::copy_n(buffer.data(), length, first), std::errc()};
+  }
+
+  if (Integer::IsNegative(n)) { *first++ = '-'; }
+  first = base == 16
+              ? internal_integer::ToHexadecimal(first, n.limbs(), n.size())
+              : internal_integer::ToDecimal(first, n.limbs(), n.size());
+  return {first, std::errc()};
+}
+
+std::from_chars_result FromChars(char const *first, char const *last,
+                                 Integer &value, int base) {
+  assert(base == 10 or base == 16);
+  auto is_digit = [base](char c) {
+    return ('0' <= c and c <= '9') or
+           (base == 16 and 'a' <= (c | 0x20) and (c | 0x20) <= 'f');
+  };
+  char const *begin = first;
+  bool negative     = begin != last and *begin == '-';
+  if (negative) { ++begin; }
+  char const *end = std::find_if_not(begin, last, is_digit);
+  if (begin == end) { return {first, std::errc::invalid_argument}; }
+
+  // Leading zeros contribute nothing but would inflate the number of limbs.
+  begin = std::find_if(begin, end - 1, [](char c) { return c != '0'; });
+  size_t digits = end - begin;
+  size_t size   = base == 16 ? internal_integer::HexadecimalLimbs(digits)
+                             : internal_integer::DecimalLimbs(digits);
+  Integer result;
+  result.EnsureCapacity(size);
+  if (base == 16) {
+    internal_integer::FromHexadecimal(result.limbs(), begin, digits);
+  } else {
+    internal_integer::FromDecimal(result.limbs(), begin, digits);
+  }
+  result.set_size(size);
+  if (negative) { result.negate(); }
+  result.ShrinkToFit();
+  value = std::move(result);
+  return {end, std::errc()};
+}
+
+std::optional<Integer> Integer::Parse(std::string_view text, int base) {
+  bool negative = text.starts_with('-');
+  if (negative) { text.remove_prefix(1); }
+  if (base == 16 and (text.starts_with("0x") or text.starts_with("0X"))) {
+    text.remove_prefix(2);
+  }
+  if (text.starts_with('-')) { return std::nullopt; }
+
+  Integer result;
+  char const *end   = text.data() + text.size();
+  auto [ptr, error] = FromChars(text.data(), end, result, base);
+  if (error != std::errc() or ptr != end) { return std::nullopt; }
+  if (negative and not result.IsZero()) { result.negate(); }
+  return result;
 }
 
 std::ostream &operator<<(std::ostream &os, Integer const &n) {
-  absl::Format(&os, "%s0x%x", Integer::IsNegative(n) ? "-" : "",
-               *n.span().rbegin());
-  for (auto iter = std::next(n.span().rbegin()); iter != n.span().rend();
-       ++iter) {
-    absl::Format(&os, "%016x", *iter);
+  bool hex = (os.flags() & std::ios_base::basefield) == std::ios_base::hex;
+  std::string buffer(MaxChars(n, hex ? 16 : 10) + 2, '\0');
+  char *out = buffer.data();
+  if (Integer::IsNegative(n)) { *out++ = '-'; }
+  if (hex) {
+    *out++ = '0';
+    *out++ = 'x';
+    out    = internal_integer::ToHexadecimal(out, n.limbs(), n.size());
+  } else {
+    out = internal_integer::ToDecimal(out, n.limbs(), n.size());
   }
-  return os;
+  return os << std::string_view(buffer.data(), out - buffer.data());
 }
 
 void Integer::EnsureCapacity(size_t capacity) {
-  if (data_[2] >= capacity) { return; }
-  data_[2]      = std::max(2 * data_[2], capacity);
-  uint64_t *ptr = new uint64_t[data_[2]];
-  std::memcpy(ptr, span().data(), span().size() * sizeof(uint64_t));
-  delete span().data();
-  data_[0] = reinterpret_cast<uintptr_t>(ptr) | (data_[0] & 1);
+  size_t current = this->capacity();
+  if (current >= capacity) { return; }
+  capacity      = std::max(2 * current, capacity);
+  size_t size   = this->size();
+  uint64_t *ptr = AllocateLimbs(capacity);
+  std::memcpy(ptr, limbs(), size * sizeof(uint64_t));
+  if (not is_inline()) { DeallocateLimbs(limbs(), current); }
+  data_[0] = reinterpret_cast<uintptr_t>(ptr);
+  data_[1] = size;
+  data_[2] = (data_[2] & kSignBit) | kHeapBit | (capacity << kMetadataBits);
 }
 
 bool Integer::IsZero() const {
@@ -204,21 +607,277 @@ bool Integer::IsZero() const {
 }
 
 void Integer::ShrinkToFit() {
-  while (span().size() > 1 and span().back() == 0) { --data_[1]; }
-  if (IsZero()) { data_[0] &= ~uintptr_t{1}; }
+  size_t size           = this->size();
+  uint64_t const *words = limbs();
+  while (size > 1 and words[size - 1] == 0) { --size; }
+  set_size(size);
+  if (IsZero()) { data_[2] &= ~kSignBit; }
 }
 
-void Integer::IncrementSize() {
-  EnsureCapacity(span().size() + 1);
-  ++data_[1];
-  span().back() = 0;
+std::pair<Integer, Integer> DivMod(Integer const &numerator,
+                                   Integer const &denominator) {
+  assert(not denominator.IsZero());
+  if (Integer::MagnitudeLess(numerator, denominator)) {
+    return std::pair<Integer, Integer>(0, numerator);
+  }
+
+  size_t numerator_size   = numerator.size();
+  size_t denominator_size = denominator.size();
+  Integer quotient, remainder;
+  quotient.EnsureCapacity(numerator_size - denominator_size + 1);
+  remainder.EnsureCapacity(denominator_size);
+  internal_integer::DivRem(quotient.limbs(), remainder.limbs(),
+                           numerator.limbs(), numerator_size,
+                           denominator.limbs(), denominator_size);
+  quotient.set_size(numerator_size - denominator_size + 1);
+  remainder.set_size(denominator_size);
+
+  if (Integer::IsNegative(numerator) != Integer::IsNegative(denominator)) {
+    quotient.negate();
+  }
+  if (Integer::IsNegative(numerator)) { remainder.negate(); }
+  quotient.ShrinkToFit();
+  remainder.ShrinkToFit();
+  return std::pair<Integer, Integer>(std::move(quotient), std::move(remainder));
+}
+
+Integer DivExact(Integer const &numerator, Integer const &denominator) {
+  assert(not denominator.IsZero());
+  size_t denominator_size = denominator.size();
+  if (denominator_size == 1) {
+    Integer result =
+        Integer::ExactWordQuotient(numerator, denominator.limbs()[0]);
+    if (Integer::IsNegative(denominator)) { result.negate(); }
+    return result;
+  }
+  if (numerator.IsZero()) { return 0; }
+
+  size_t numerator_size = numerator.size();
+  assert(numerator_size >= denominator_size);
+  size_t size = numerator_size - denominator_size + 1;
+  Integer result;
+  result.EnsureCapacity(size);
+  internal_integer::DivExact(result.limbs(), numerator.limbs(), numerator_size,
+                             denominator.limbs(), denominator_size);
+  result.set_size(size);
+  if (Integer::IsNegative(numerator) != Integer::IsNegative(denominator)) {
+    result.negate();
+  }
+  result.ShrinkToFit();
+  return result;
 }
 
 Integer operator/(Integer const &lhs, Integer const &rhs) {
-  // TODO: Fully implement this.
-  assert(lhs.span().size() == 1);
-  assert(rhs.span().size() == 1);
-  return lhs.span()[0] / rhs.span()[0];
+  return DivMod(lhs, rhs).first;
+}
+
+Integer operator%(Integer const &lhs, Integer const &rhs) {
+  return DivMod(lhs, rhs).second;
+}
+
+Integer &Integer::operator<<=(uint64_t shift) {
+  if (shift == 0 or IsZero()) { return *this; }
+  size_t size  = this->size();
+  size_t words = shift / 64;
+  int bits     = shift % 64;
+  EnsureCapacity(size + words + 1);
+  uint64_t *limbs = this->limbs();
+  if (bits == 0) {
+    std::copy_backward(limbs, limbs + size, limbs + size + words);
+    limbs[size + words] = 0;
+  } else {
+    limbs[size + words] =
+        internal_integer::ShiftLeft(limbs + words, limbs, size, bits);
+  }
+  std::fill_n(limbs, words, 0);
+  set_size(size + words + 1);
+  ShrinkToFit();
+  return *this;
+}
+
+Integer &Integer::operator>>=(uint64_t shift) {
+  if (shift == 0) { return *this; }
+  bool negative   = IsNegative(*this);
+  size_t size     = this->size();
+  size_t words    = shift / 64;
+  int bits        = shift % 64;
+  uint64_t *limbs = this->limbs();
+  // A negative value rounds away from zero if any set bit is shifted out.
+  bool inexact = true;
+  if (words < size) {
+    inexact = std::any_of(limbs, limbs + words, [](uint64_t l) { return l != 0; });
+    if (bits == 0) {
+      std::copy(limbs + words, limbs + size, limbs);
+    } else {
+      inexact |= internal_integer::ShiftRight(limbs, limbs + words,
+                                              size - words, bits) != 0;
+    }
+    set_size(size - words);
+  } else {
+    limbs[0] = 0;
+    set_size(1);
+  }
+  ShrinkToFit();
+  if (negative and inexact) { AddWord(1, true); }
+  return *this;
+}
+
+Integer &Integer::Bitwise(Integer const &rhs, char op) {
+  if (&rhs == this) {
+    if (op == '^') { Reset(); }
+    return *this;
+  }
+  bool a_negative = IsNegative(*this);
+  bool b_negative = IsNegative(rhs);
+  bool negative   = op == '&'   ? a_negative and b_negative
+                    : op == '|' ? a_negative or b_negative
+                                : a_negative != b_negative;
+  size_t n        = std::max(size(), rhs.size());
+  EnsureCapacity(n + 1);
+  uint64_t *limbs = this->limbs();
+  TwosComplementReader a{limbs, size(), a_negative};
+  TwosComplementReader b{rhs.limbs(), rhs.size(), b_negative};
+  switch (op) {
+    case '&':
+      BitwiseLimbs(limbs, a, b, n, negative,
+                   [](uint64_t x, uint64_t y) { return x & y; });
+      break;
+    case '|':
+      BitwiseLimbs(limbs, a, b, n, negative,
+                   [](uint64_t x, uint64_t y) { return x | y; });
+      break;
+    case '^':
+      BitwiseLimbs(limbs, a, b, n, negative,
+                   [](uint64_t x, uint64_t y) { return x ^ y; });
+      break;
+    default: assert(false);
+  }
+  set_size(n + 1);
+  data_[2] = (data_[2] & ~kSignBit) | (negative ? kSignBit : 0);
+  ShrinkToFit();
+  return *this;
+}
+
+uint64_t BitLength(Integer const &n) {
+  size_t size = n.size();
+  return 64 * (size - 1) + std::bit_width(n.limbs()[size - 1]);
+}
+
+uint64_t PopCount(Integer const &n) {
+  uint64_t count = 0;
+  for (uint64_t limb : n.span()) { count += std::popcount(limb); }
+  return count;
+}
+
+uint64_t CountTrailingZeros(Integer const &n) {
+  assert(not n.IsZero());
+  absl::Span<uint64_t const> limbs = n.span();
+  size_t i                         = 0;
+  while (limbs[i] == 0) { ++i; }
+  return 64 * i + std::countr_zero(limbs[i]);
+}
+
+bool TestBit(Integer const &n, uint64_t k) {
+  return (TwosComplementLimb(n.span(), Integer::IsNegative(n), k / 64) >>
+          (k % 64)) &
+         1;
+}
+
+uint64_t ExtractBits(Integer const &n, uint64_t offset, int count) {
+  assert(0 <= count and count <= 64);
+  if (count == 0) { return 0; }
+  bool negative = Integer::IsNegative(n);
+  size_t word   = offset / 64;
+  int bit       = offset % 64;
+  uint64_t bits = TwosComplementLimb(n.span(), negative, word) >> bit;
+  if (bit != 0 and count > 64 - bit) {
+    bits |= TwosComplementLimb(n.span(), negative, word + 1) << (64 - bit);
+  }
+  return count == 64 ? bits : bits & ((uint64_t{1} << count) - 1);
+}
+
+Integer Gcd(Integer const &a, Integer const &b) {
+  if (a.IsZero() or b.IsZero()) {
+    Integer result = a.IsZero() ? b : a;
+    if (Integer::IsNegative(result)) { result.negate(); }
+    return result;
+  }
+
+  size_t a_size = a.size();
+  size_t b_size = b.size();
+  Integer result;
+  result.EnsureCapacity(std::min(a_size, b_size));
+  result.set_size(internal_integer::Gcd(result.limbs(), a.limbs(), a_size,
+                                        b.limbs(), b_size));
+  result.ShrinkToFit();
+  return result;
+}
+
+std::tuple<Integer, Integer, Integer> ExtendedGcd(Integer const &a,
+                                                  Integer const &b) {
+  if (a.IsZero() or b.IsZero()) {
+    Integer g = a.IsZero() ? b : a;
+    Integer x = a.IsZero() ? 0 : 1;
+    Integer y = a.IsZero() and not b.IsZero() ? 1 : 0;
+    if (Integer::IsNegative(a)) { x.negate(); }
+    if (Integer::IsNegative(b)) { y.negate(); }
+    if (Integer::IsNegative(g)) { g.negate(); }
+    return {std::move(g), std::move(x), std::move(y)};
+  }
+
+  size_t a_size = a.size();
+  size_t b_size = b.size();
+  Integer g, x, y;
+  g.EnsureCapacity(std::min(a_size, b_size));
+  x.EnsureCapacity(b_size);
+  y.EnsureCapacity(a_size);
+  bool negated;
+  g.set_size(internal_integer::ExtendedGcd(g.limbs(), x.limbs(), y.limbs(),
+                                           negated, a.limbs(), a_size,
+                                           b.limbs(), b_size));
+  x.set_size(b_size);
+  y.set_size(a_size);
+  g.ShrinkToFit();
+  x.ShrinkToFit();
+  y.ShrinkToFit();
+
+  // The magnitudes satisfy `|a| * x - |b| * y == ±g`, with the sign given by
+  // `negated`, so the signs of the coefficients follow from those of `a`, `b`
+  // and `negated`.
+  if (Integer::IsNegative(a) != negated) { x.negate(); }
+  if (Integer::IsNegative(b) == negated) { y.negate(); }
+  return {std::move(g), std::move(x), std::move(y)};
+}
+
+Integer Lcm(Integer const &a, Integer const &b) {
+  if (a.IsZero() or b.IsZero()) { return 0; }
+  Integer result = a / Gcd(a, b) * b;
+  if (Integer::IsNegative(result)) { result.negate(); }
+  return result;
+}
+
+Integer Integer::Root(Integer const &n, uint64_t k) {
+  size_t size = internal_integer::RootSize(n.size(), k);
+  Integer result;
+  result.EnsureCapacity(size);
+  internal_integer::Root(result.limbs(), n.limbs(), n.size(), k);
+  result.set_size(size);
+  result.ShrinkToFit();
+  if (IsNegative(n)) { result.negate(); }
+  return result;
+}
+
+Integer Sqrt(Integer const &n) {
+  assert(not Integer::IsNegative(n));
+  return Integer::Root(n, 2);
+}
+
+std::pair<Integer, Integer> RootRem(Integer const &n, uint64_t k) {
+  assert(k > 0);
+  assert(k % 2 == 1 or not Integer::IsNegative(n));
+  Integer root      = Integer::Root(n, k);
+  Integer remainder = n - Pow(root, k);
+  return {std::move(root), std::move(remainder)};
 }
 
 bool operator==(Integer const &lhs, Integer const &rhs) {
@@ -240,8 +899,8 @@ bool Integer::MagnitudeLess(Integer const &lhs, Integer const &rhs) {
   auto rhs_iter = rhs.span().end() - 1;
   auto lhs_end  = lhs.span().begin() - 1;
   for (; lhs_iter != lhs_end; --lhs_iter, --rhs_iter) {
-    if (*lhs_iter < *rhs_iter) { return not Integer::IsNegative(lhs); }
-    if (*lhs_iter > *rhs_iter) { return Integer::IsNegative(lhs); }
+    if (*lhs_iter < *rhs_iter) { return true; }
+    if (*lhs_iter > *rhs_iter) { return false; }
   }
   return false;
 }
@@ -249,7 +908,8 @@ bool Integer::MagnitudeLess(Integer const &lhs, Integer const &rhs) {
 bool operator<(Integer const &lhs, Integer const &rhs) {
   if (lhs.sign() < rhs.sign()) { return true; }
   if (lhs.sign() > rhs.sign()) { return false; }
-  return Integer::MagnitudeLess(lhs, rhs);
+  return Integer::IsNegative(lhs) ? Integer::MagnitudeLess(rhs, lhs)
+                                  : Integer::MagnitudeLess(lhs, rhs);
 }
 
 }  // namespace chalk
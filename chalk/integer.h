@@ -3,13 +3,21 @@
 
 #include <algorithm>
 #include <cassert>
+#include <charconv>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <optional>
 #include <ostream>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
 
 #include "absl/types/span.h"
+#include "chalk/integer_thresholds.h"
 
 namespace chalk {
 namespace internal_integer {
@@ -25,8 +33,7 @@ auto as_unsigned(std::integral auto n) -> std::make_unsigned_t<decltype(n)> {
 struct Integer {
   Integer(uint64_t n = 0);
 
-  Integer(std::signed_integral auto n)
-      : Integer(static_cast<uint64_t>(std::abs(n))) {
+  Integer(std::signed_integral auto n) : Integer(SplitSign(n).first) {
     if (n < 0) { negate(); }
   }
 
@@ -43,13 +50,8 @@ struct Integer {
   // Comparisons
   friend bool operator==(Integer const &lhs, Integer const &rhs);
   friend bool operator==(std::integral auto lhs, Integer const &rhs) {
-    if (rhs.span().size() != 1) { return false; }
-    if constexpr (std::signed_integral<decltype(lhs)>) {
-      return ((lhs >= 0) ^ IsNegative(rhs)) and
-             rhs.span()[0] == static_cast<uint64_t>(std::abs(lhs));
-    } else {
-      return not IsNegative(rhs) and rhs.span()[0] == lhs;
-    }
+    auto [magnitude, negative] = SplitSign(lhs);
+    return CompareToWord(rhs, magnitude, negative) == 0;
   }
   friend bool operator==(Integer const &lhs, std::integral auto rhs) {
     return rhs == lhs;
@@ -68,47 +70,13 @@ struct Integer {
   friend bool operator<(Integer const &lhs, Integer const &rhs);
 
   friend bool operator<(std::integral auto lhs, Integer const &rhs) {
-    if constexpr (std::signed_integral<decltype(lhs)>) {
-      if (IsNegative(lhs)) {
-        if (IsNegative(rhs)) {
-          return rhs.span().size() == 1 and
-                 internal_integer::as_unsigned(-lhs) > rhs.span()[0];
-        } else {
-          return true;
-        }
-      } else {
-        if (IsNegative(rhs)) {
-          return false;
-        } else {
-          return rhs.span().size() > 1 or
-                 internal_integer::as_unsigned(lhs) < rhs.span()[0];
-        }
-      }
-    } else {
-      return rhs.span().size() > 1 or lhs < rhs.span()[0];
-    }
+    auto [magnitude, negative] = SplitSign(lhs);
+    return CompareToWord(rhs, magnitude, negative) > 0;
   }
 
   friend bool operator<(Integer const &lhs, std::integral auto rhs) {
-    if constexpr (std::signed_integral<decltype(rhs)>) {
-      if (IsNegative(rhs)) {
-        if (IsNegative(lhs)) {
-          return lhs.span().size() > 1 or
-                 lhs.span()[0] > internal_integer::as_unsigned(-rhs);
-        } else {
-          return false;
-        }
-      } else {
-        if (IsNegative(lhs)) {
-          return true;
-        } else {
-          return lhs.span().size() == 1 and
-                 lhs.span()[0] < internal_integer::as_unsigned(rhs);
-        }
-      }
-    } else {
-      return lhs.span().size() > 1 or lhs.span()[0] > lhs;
-    }
+    auto [magnitude, negative] = SplitSign(rhs);
+    return CompareToWord(lhs, magnitude, negative) < 0;
   }
 
   friend bool operator<=(Integer const &lhs, Integer const &rhs) {
@@ -144,8 +112,8 @@ struct Integer {
   // Addition
   Integer &operator+=(Integer const &rhs);
   Integer &operator+=(std::integral auto rhs) {
-    // TODO: Improve this implementation.
-    return *this += Integer(rhs);
+    auto [magnitude, negative] = SplitSign(rhs);
+    return AddWord(magnitude, negative);
   }
 
   friend Integer operator+(Integer lhs, Integer const &rhs) {
@@ -167,8 +135,8 @@ struct Integer {
   // Subtraction
   Integer &operator-=(Integer const &rhs);
   Integer &operator-=(std::integral auto rhs) {
-    // TODO: Improve this implementation.
-    return *this -= Integer(rhs);
+    auto [magnitude, negative] = SplitSign(rhs);
+    return AddWord(magnitude, not negative);
   }
 
   friend Integer operator-(Integer lhs, Integer const &rhs) {
@@ -178,13 +146,13 @@ struct Integer {
   friend Integer operator-(Integer const &lhs, Integer &&rhs) {
     rhs -= lhs;
     rhs.negate();
-    return -std::move(rhs);
+    return std::move(rhs);
   }
 
   friend Integer operator-(std::integral auto lhs, Integer rhs) {
     rhs -= lhs;
     rhs.negate();
-    return -std::move(rhs);
+    return rhs;
   }
 
   friend Integer operator-(Integer lhs, std::integral auto rhs) {
@@ -192,17 +160,25 @@ struct Integer {
     return lhs;
   }
 
+  // Requires the value to be representable as a `T`.
   template <std::integral T>
   operator T() const {
-    assert(span().size() == 1);
+    assert(size() == 1);
+    uint64_t magnitude = limbs()[0];
     if constexpr (std::is_unsigned_v<T>) {
-      return span()[0];
+      assert(not IsNegative(*this));
+      assert(magnitude <= std::numeric_limits<T>::max());
+      return static_cast<T>(magnitude);
     } else {
+      using U = std::make_unsigned_t<T>;
       if (IsNegative(*this)) {
-        // TODO: Possible data loss here.
-        return -static_cast<int64_t>(span()[0]);
+        assert(magnitude <= U{std::numeric_limits<T>::max()} + 1);
+        // Conversion to a signed type is modular, so negating the magnitude
+        // as an unsigned value yields the negative value exactly.
+        return static_cast<T>(static_cast<U>(0 - magnitude));
       } else {
-        return span()[0];
+        assert(magnitude <= U{std::numeric_limits<T>::max()});
+        return static_cast<T>(magnitude);
       }
     }
   }
@@ -211,27 +187,34 @@ struct Integer {
   Integer operator-() const &;
   Integer operator-() &;
   Integer operator-() &&;
-  void negate() { data_[0] ^= 1; }
+  void negate() {
+    if (not IsZero()) { data_[2] ^= kSignBit; }
+  }
 
   // Multiplication
   friend Integer operator*(Integer const &lhs, Integer const &rhs);
 
-  friend Integer operator*(std::integral auto lhs, Integer rhs) {
-    return rhs *= lhs;
-  }
-
   friend Integer operator*(Integer const &lhs, std::integral auto rhs) {
-    return lhs *= rhs;
+    auto [magnitude, negative] = SplitSign(rhs);
+    Integer result = WordProduct(lhs, magnitude);
+    if (negative) { result.negate(); }
+    return result;
+  }
+  friend Integer operator*(Integer &&lhs, std::integral auto rhs) {
+    lhs *= rhs;
+    return std::move(lhs);
+  }
+  friend Integer operator*(std::integral auto lhs, Integer const &rhs) {
+    return rhs * lhs;
+  }
+  friend Integer operator*(std::integral auto lhs, Integer &&rhs) {
+    return std::move(rhs) * lhs;
   }
 
   Integer &operator*=(std::integral auto n) {
-    if constexpr (std::is_signed_v<decltype(n)>) {
-      if (n < 0) {
-        negate();
-        n *= -1;
-      }
-    }
-    MultiplyBy(static_cast<std::make_unsigned_t<decltype(n)>>(n));
+    auto [magnitude, negative] = SplitSign(n);
+    MultiplyBy(magnitude);
+    if (negative) { negate(); }
     return *this;
   }
 
@@ -240,49 +223,340 @@ struct Integer {
     return *this;
   }
 
-  // Division operations
+  // Returns `*this * *this`, computing the products of distinct limbs once
+  // rather than twice. Multiplying an `Integer` by itself, as in `x * x` or
+  // `x *= x`, also squares.
+  Integer Square() const;
+
+  // Returns `base` raised to `exponent`, where `0^0` is one, by left-to-right
+  // sliding-window exponentiation using the squaring kernels.
+  friend Integer Pow(Integer const &base, uint64_t exponent);
+
+  // Returns the product of `factors`, or one if there are none. Machine words
+  // are first packed into as few words as hold their products. The product is
+  // then formed up a binary tree whose subtrees hold similar numbers of limbs,
+  // so that large multiplications have operands of similar lengths and benefit
+  // from subquadratic algorithms, where multiplying from left to right would
+  // repeatedly multiply a long partial product by a short factor. Independent
+  // subtrees are multiplied as concurrent tasks on `CurrentIntegerExecutor()`,
+  // though subtrees too small to repay the cost of a task stay on the calling
+  // thread. The factors must not be modified until the product is returned.
+  friend Integer ProductOf(absl::Span<Integer const> factors);
+  friend Integer ProductOf(absl::Span<uint64_t const> factors);
+
+  // Fused multiply-add operations, setting `*this` to `*this + a * b` and
+  // `*this - a * b` respectively. Unless the product is large enough to
+  // warrant subquadratic multiplication, it is accumulated directly into the
+  // limbs of `*this` rather than materialized as a temporary. Either operand
+  // may alias `*this`.
+  Integer &AddMul(Integer const &a, Integer const &b);
+  Integer &SubMul(Integer const &a, Integer const &b);
+  Integer &AddMul(Integer const &a, std::integral auto b) {
+    auto [magnitude, negative] = SplitSign(b);
+    return AddMulWord(a, magnitude, IsNegative(a) != negative);
+  }
+  Integer &SubMul(Integer const &a, std::integral auto b) {
+    auto [magnitude, negative] = SplitSign(b);
+    return AddMulWord(a, magnitude, IsNegative(a) == negative);
+  }
+
+  // Division operations. As with built-in integers, quotients are truncated
+  // towards zero and remainders take the sign of the numerator. Each requires
+  // a non-zero denominator.
   friend Integer operator/(Integer const &lhs, Integer const &rhs);
   Integer &operator/=(Integer const &rhs) {
     *this = *this / rhs;
     return *this;
   }
 
+  friend Integer operator%(Integer const &lhs, Integer const &rhs);
+  Integer &operator%=(Integer const &rhs) {
+    *this = *this % rhs;
+    return *this;
+  }
+
+  friend Integer operator/(Integer lhs, std::integral auto rhs) {
+    return lhs /= rhs;
+  }
+  Integer &operator/=(std::integral auto rhs) {
+    auto [magnitude, negative] = SplitSign(rhs);
+    DivideByWord(magnitude);
+    if (negative) { negate(); }
+    return *this;
+  }
+
+  friend Integer operator%(Integer const &lhs, std::integral auto rhs) {
+    Integer result = WordRemainder(lhs, SplitSign(rhs).first);
+    if (IsNegative(lhs)) { result.negate(); }
+    return result;
+  }
+  Integer &operator%=(std::integral auto rhs) {
+    return *this = *this % rhs;
+  }
+
+  // Returns the quotient and remainder of `numerator / denominator`, both
+  // computed by a single division.
+  friend std::pair<Integer, Integer> DivMod(Integer const &numerator,
+                                            Integer const &denominator);
+
+  // Returns `numerator / denominator`, where `denominator` is non-zero and
+  // divides `numerator` exactly. Exact quotients are computed from the least
+  // significant limb by Hensel division, without estimating quotient limbs,
+  // which is considerably faster than `operator/` for short divisors.
+  friend Integer DivExact(Integer const &numerator, Integer const &denominator);
+  friend Integer DivExactByWord(Integer const &numerator,
+                                std::integral auto denominator) {
+    auto [magnitude, negative] = SplitSign(denominator);
+    Integer result             = ExactWordQuotient(numerator, magnitude);
+    if (negative) { result.negate(); }
+    return result;
+  }
+
+  // Shifts. `n << k` is `n * 2^k`, and `n >> k` is `n / 2^k` rounded towards
+  // negative infinity, as an arithmetic shift of a two's-complement value
+  // would, so that `-1 >> k` is -1. Each shifts the limbs in place, a word at
+  // a time.
+  Integer &operator<<=(uint64_t shift);
+  Integer &operator>>=(uint64_t shift);
+  friend Integer operator<<(Integer lhs, uint64_t shift) {
+    return lhs <<= shift;
+  }
+  friend Integer operator>>(Integer lhs, uint64_t shift) {
+    return lhs >>= shift;
+  }
+
+  // Bitwise operations. Values are treated as two's-complement with infinitely
+  // many sign bits, as for Python integers, so that `~n == -n - 1` and, for
+  // instance, `n & -n` is the lowest set bit of `n`. Negative operands are
+  // converted to and from two's complement limb by limb as the operation
+  // proceeds, without materializing a temporary.
+  Integer &operator&=(Integer const &rhs) { return Bitwise(rhs, '&'); }
+  Integer &operator|=(Integer const &rhs) { return Bitwise(rhs, '|'); }
+  Integer &operator^=(Integer const &rhs) { return Bitwise(rhs, '^'); }
+  friend Integer operator&(Integer lhs, Integer const &rhs) {
+    return lhs &= rhs;
+  }
+  friend Integer operator|(Integer lhs, Integer const &rhs) {
+    return lhs |= rhs;
+  }
+  friend Integer operator^(Integer lhs, Integer const &rhs) {
+    return lhs ^= rhs;
+  }
+  friend Integer operator~(Integer n) {
+    n.negate();
+    return n -= 1;
+  }
+
+  // Returns the number of bits in the magnitude of `n`, which is zero only if
+  // `n` is zero.
+  friend uint64_t BitLength(Integer const &n);
+
+  // Returns the number of set bits in the magnitude of `n`.
+  friend uint64_t PopCount(Integer const &n);
+
+  // Returns the number of trailing zero bits of `n`, which is the exponent of
+  // the largest power of two dividing it. Requires `n` to be non-zero.
+  friend uint64_t CountTrailingZeros(Integer const &n);
+
+  // Returns bit `k` of the two's-complement representation of `n`.
+  friend bool TestBit(Integer const &n, uint64_t k);
+
+  // Returns the `count` bits of the two's-complement representation of `n`
+  // starting at bit `offset`, in the low bits of the result. Requires
+  // `count <= 64`.
+  friend uint64_t ExtractBits(Integer const &n, uint64_t offset, int count);
+
+  // Returns the greatest common divisor of `a` and `b`, which is non-negative
+  // and is zero only if both are zero. Values of more than one limb are reduced
+  // by Lehmer's algorithm, and large values by a subquadratic half-gcd.
+  friend Integer Gcd(Integer const &a, Integer const &b);
+
+  // Returns `(g, x, y)` with `g == Gcd(a, b)` and `a * x + b * y == g`. When
+  // `a` and `b` are both non-zero, the coefficients are those found by Euclid's
+  // algorithm, with `|x| <= |b| / g` and `|y| <= |a| / g`.
+  friend std::tuple<Integer, Integer, Integer> ExtendedGcd(Integer const &a,
+                                                           Integer const &b);
+
+  // Returns the least common multiple of `a` and `b`, which is non-negative and
+  // is zero if either is zero.
+  friend Integer Lcm(Integer const &a, Integer const &b);
+
+  // Returns the largest integer whose square is at most `n`, which must be
+  // non-negative.
+  friend Integer Sqrt(Integer const &n);
+
+  // Returns `(r, n - r^k)`, where `r` is the `k`-th root of `n` truncated
+  // towards zero, so that the remainder takes the sign of `n`. Requires `k` to
+  // be positive, and `n` to be non-negative if `k` is even. Roots are computed
+  // by Newton's iteration from an estimate of the root of the leading limbs.
+  friend std::pair<Integer, Integer> RootRem(Integer const &n, uint64_t k);
+
+  // Writes `n` in base `base`, which must be 10 or 16, to `[first, last)`.
+  // Hexadecimal digits are lowercase and, as with `std::to_chars`, no prefix is
+  // written. Returns a pointer past the last character written or, if the
+  // buffer is too small, `last` and `std::errc::value_too_large`, in which case
+  // the contents of the buffer are unspecified. Large values are converted to
+  // decimal in subquadratic time.
+  friend std::to_chars_result ToChars(char *first, char *last,
+                                      Integer const &n, int base);
+
+  // Returns an upper bound on the number of characters `ToChars` writes for
+  // `n` in base `base`.
+  friend size_t MaxChars(Integer const &n, int base);
+
+  // Parses an optional '-' followed by digits in base `base`, which must be 10
+  // or 16, from `[first, last)`. As with `std::from_chars`, neither a '+' nor a
+  // prefix is accepted, and as many digits as possible are consumed. On
+  // success, sets `value` and returns a pointer past the last digit. If there
+  // are no digits, returns `first` and `std::errc::invalid_argument`, leaving
+  // `value` unmodified. Large decimal values are parsed in subquadratic time.
+  friend std::from_chars_result FromChars(char const *first, char const *last,
+                                          Integer &value, int base);
+
+  // Returns the value represented by the entirety of `text` in base `base`,
+  // which must be 10 or 16, or `std::nullopt` if `text` is not such a
+  // representation. Hexadecimal text may have a "0x" prefix following any sign,
+  // so that values written with `std::hex` can be read back.
+  static std::optional<Integer> Parse(std::string_view text, int base = 10);
+
+  // Writes `n` in decimal or, if the basefield of `os` is `std::hex`, in
+  // hexadecimal with a "0x" prefix.
   friend std::ostream &operator<<(std::ostream &os, Integer const &n);
 
   static bool IsNegative(std::signed_integral auto n) { return n < 0; }
   static bool IsNegative(Integer const &n) { return n.sign() < 0; }
 
  private:
-  int sign() const { return data_[0] & 1 ? -1 : 1; }
+  template <size_t>
+  friend struct FixedInteger;
+  friend struct IntegerAccumulator;
+  friend struct MontgomeryContext;
+  friend struct Rational;
+
+  // Values whose magnitude fits in at most `kInlineCapacity` limbs are stored
+  // directly in `data_[0]` and `data_[1]` and never touch the allocator. Larger
+  // values spill to the heap, in which case `data_[0]` holds a pointer to the
+  // limbs and `data_[1]` holds the number of limbs in use. In either
+  // representation, `data_[2]` holds the sign in its lowest bit, a bit
+  // indicating whether the limbs live on the heap, and in its remaining bits
+  // either the inline size or the heap capacity.
+  static constexpr size_t kInlineCapacity = 2;
+  static constexpr uint64_t kSignBit      = 1;
+  static constexpr uint64_t kHeapBit      = 2;
+  static constexpr int kMetadataBits      = 2;
+
+  int sign() const { return data_[2] & kSignBit ? -1 : 1; }
+
+  bool is_inline() const { return not(data_[2] & kHeapBit); }
+  size_t size() const {
+    return is_inline() ? data_[2] >> kMetadataBits : data_[1];
+  }
+  size_t capacity() const {
+    return is_inline() ? kInlineCapacity : data_[2] >> kMetadataBits;
+  }
+  void set_size(size_t n) {
+    if (is_inline()) {
+      data_[2] = (data_[2] & (kSignBit | kHeapBit)) | (n << kMetadataBits);
+    } else {
+      data_[1] = n;
+    }
+  }
 
-  absl::Span<uint64_t> span() {
-    return absl::MakeSpan(
-        reinterpret_cast<uint64_t *>(data_[0] & ~uintptr_t{1}), data_[1]);
+  uint64_t *limbs() {
+    return is_inline() ? data_ : reinterpret_cast<uint64_t *>(data_[0]);
   }
+  uint64_t const *limbs() const {
+    return is_inline() ? data_ : reinterpret_cast<uint64_t const *>(data_[0]);
+  }
+
+  absl::Span<uint64_t> span() { return absl::MakeSpan(limbs(), size()); }
   absl::Span<uint64_t const> span() const {
-    return absl::MakeConstSpan(
-        reinterpret_cast<uint64_t *>(data_[0] & ~uintptr_t{1}), data_[1]);
+    return absl::MakeConstSpan(limbs(), size());
   }
 
+  // Releases any heap storage and resets `*this` to zero.
+  void Reset();
+
   void EnsureCapacity(size_t capacity);
   void ShrinkToFit();
-  void IncrementSize();
   bool IsZero() const;
 
-  // SignSafe* applies the given operation, ignoring signs, and assuming
-  // sign-change does not occur due to the operation.
-  Integer &SignSafeAddition(Integer const &, uintptr_t);
-  Integer &SignSafeAddition(int64_t, uintptr_t);
-  Integer &SignSafeSubtraction(Integer const &, uintptr_t);
-  Integer &SignSafeSubtraction(int64_t, uintptr_t);
+  // SignSafe* applies the given operation to the magnitudes of `*this` and the
+  // argument, retaining the sign of `*this` unless the magnitude of the
+  // argument is larger, in which case the sign flips.
+  Integer &SignSafeAddition(Integer const &);
+  Integer &SignSafeSubtraction(Integer const &);
 
+  // Multiplies the magnitude of `*this` by `n`.
   void MultiplyBy(uint64_t n);
 
+  // Divides the magnitude of `*this` by `n`, truncating, and returns the
+  // remainder. Requires `n` to be non-zero.
+  uint64_t DivideByWord(uint64_t n);
+
+  // Returns the magnitude of `n` multiplied by `m`, carrying the sign of `n`.
+  static Integer WordProduct(Integer const &n, uint64_t m);
+
+  // Returns the magnitude of `n` divided by `m`, which must be non-zero and
+  // divide `n` exactly, carrying the sign of `n`.
+  static Integer ExactWordQuotient(Integer const &n, uint64_t m);
+
+  // Returns the remainder of the magnitude of `n` divided by `m`, which must
+  // be non-zero.
+  static Integer WordRemainder(Integer const &n, uint64_t m);
+
+  // Returns the `k`-th root of the magnitude of `n`, truncated, carrying the
+  // sign of `n`.
+  static Integer Root(Integer const &n, uint64_t k);
+
+  // Adds the word with the given magnitude and sign to `*this`.
+  Integer &AddWord(uint64_t magnitude, bool negative);
+
+  // Returns a negative number, zero, or a positive number according to whether
+  // `n` is less than, equal to, or greater than the word with the given
+  // magnitude and sign.
+  static int CompareToWord(Integer const &n, uint64_t magnitude,
+                           bool negative) {
+    if (IsNegative(n) != negative) { return negative ? 1 : -1; }
+    int comparison = 1;
+    if (n.size() == 1) {
+      uint64_t low = n.limbs()[0];
+      comparison   = static_cast<int>(low > magnitude) - (low < magnitude);
+    }
+    return negative ? -comparison : comparison;
+  }
+
+  // Returns the magnitude of `n` and whether `n` is negative.
+  static std::pair<uint64_t, bool> SplitSign(std::integral auto n) {
+    if constexpr (std::signed_integral<decltype(n)>) {
+      if (n < 0) { return {uint64_t{0} - static_cast<uint64_t>(n), true}; }
+    }
+    return {static_cast<uint64_t>(n), false};
+  }
+
+  // Adds the product of the magnitudes of `a` and `b[0, bn)`, negated if
+  // `negative_product` is set, to `*this`. Neither operand may alias `*this`.
+  Integer &MultiplyAccumulate(Integer const &a, uint64_t const *b, size_t bn,
+                              bool negative_product);
+  Integer &AddMulWord(Integer const &a, uint64_t b, bool negative_product);
+
   static bool MagnitudeLess(Integer const &lhs, Integer const &rhs);
 
-  uintptr_t data_[3];
+  // Applies the bitwise operation `op`, one of '&', '|' or '^', to `*this`
+  // and `rhs`, which may alias `*this`.
+  Integer &Bitwise(Integer const &rhs, char op);
+
+  uint64_t data_[3];
 };
 
+std::to_chars_result ToChars(char *first, char *last, Integer const &n,
+                             int base = 10);
+size_t MaxChars(Integer const &n, int base = 10);
+Integer ProductOf(absl::Span<Integer const> factors);
+Integer ProductOf(absl::Span<uint64_t const> factors);
+std::from_chars_result FromChars(char const *first, char const *last,
+                                 Integer &value, int base = 10);
+
 }  // namespace chalk
 
 #endif  // CHALK_INTEGER_H
@@ -0,0 +1,124 @@
+#include "chalk/integer_accumulator.h"
+
+#include <algorithm>
+
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/multiply.h"
+
+namespace chalk {
+namespace {
+
+// Adds `a[0, n)` to `sum[0, n)` limb by limb, adding the carry out of each
+// limb `i` to `carries[i + 1]` rather than to the next limb of the sum. Without
+// a carry chain from one limb to the next, the loop vectorizes.
+void AddCarrySave(uint64_t *sum, uint64_t *carries, uint64_t const *a,
+                  size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t limb = sum[i] + a[i];
+    carries[i + 1] += limb < a[i];
+    sum[i] = limb;
+  }
+}
+
+}  // namespace
+
+IntegerAccumulator::IntegerAccumulator(size_t limbs) {
+  Widen(std::max<size_t>(limbs, 1));
+}
+
+void IntegerAccumulator::Widen(size_t limbs) {
+  if (limbs <= width()) { return; }
+  limbs = std::max(limbs, 2 * width());
+  for (Sum &sum : sums_) {
+    sum.limbs.resize(limbs, 0);
+    sum.carries.resize(limbs + 1, 0);
+  }
+}
+
+IntegerAccumulator &IntegerAccumulator::AddLimbs(uint64_t const *a, size_t n,
+                                                 bool negative) {
+  n = internal_integer::Normalized(a, n);
+  Widen(n);
+  Sum &sum = sums_[negative];
+  AddCarrySave(sum.limbs.data(), sum.carries.data(), a, n);
+  return *this;
+}
+
+IntegerAccumulator &IntegerAccumulator::AddWord(uint64_t magnitude,
+                                                bool negative) {
+  Sum &sum = sums_[negative];
+  AddCarrySave(sum.limbs.data(), sum.carries.data(), &magnitude, 1);
+  return *this;
+}
+
+IntegerAccumulator &IntegerAccumulator::operator+=(Integer const &n) {
+  return AddLimbs(n.limbs(), n.size(), Integer::IsNegative(n));
+}
+
+IntegerAccumulator &IntegerAccumulator::operator-=(Integer const &n) {
+  return AddLimbs(n.limbs(), n.size(), not Integer::IsNegative(n));
+}
+
+IntegerAccumulator &IntegerAccumulator::AddMulWord(Integer const &a,
+                                                   uint64_t b,
+                                                   bool negative_product) {
+  size_t n = a.size();
+  scratch_.resize(std::max(scratch_.size(), n + 1));
+  scratch_[n] = internal_integer::MulOne(scratch_.data(), a.limbs(), n, b);
+  return AddLimbs(scratch_.data(), n + 1, negative_product);
+}
+
+IntegerAccumulator &IntegerAccumulator::AddProduct(Integer const &a,
+                                                   Integer const &b,
+                                                   bool negative_product) {
+  size_t n = a.size() + b.size();
+  scratch_.resize(std::max(scratch_.size(), n));
+  internal_integer::Multiply(scratch_.data(), a.limbs(), a.size(), b.limbs(),
+                             b.size());
+  return AddLimbs(scratch_.data(), n, negative_product);
+}
+
+IntegerAccumulator &IntegerAccumulator::AddMul(Integer const &a,
+                                               Integer const &b) {
+  return AddProduct(a, b, Integer::IsNegative(a) != Integer::IsNegative(b));
+}
+
+IntegerAccumulator &IntegerAccumulator::SubMul(Integer const &a,
+                                               Integer const &b) {
+  return AddProduct(a, b, Integer::IsNegative(a) == Integer::IsNegative(b));
+}
+
+Integer IntegerAccumulator::value() const {
+  // Resolving the carries of each sum yields a value of at most `width() + 1`
+  // limbs, since the carries count fewer than `2^64` terms.
+  size_t n = width() + 1;
+  std::vector<uint64_t> negative(n);
+  Sum const &sum = sums_[1];
+  internal_integer::Add(negative.data(), sum.carries.data(), n,
+                        sum.limbs.data(), n - 1);
+
+  Integer result;
+  result.EnsureCapacity(n);
+  uint64_t *r = result.limbs();
+  internal_integer::Add(r, sums_[0].carries.data(), n, sums_[0].limbs.data(),
+                        n - 1);
+  if (internal_integer::Compare(r, negative.data(), n) >= 0) {
+    internal_integer::SubN(r, r, negative.data(), n);
+    result.set_size(n);
+  } else {
+    internal_integer::SubN(r, negative.data(), r, n);
+    result.set_size(n);
+    result.negate();
+  }
+  result.ShrinkToFit();
+  return result;
+}
+
+void IntegerAccumulator::clear() {
+  for (Sum &sum : sums_) {
+    std::fill(sum.limbs.begin(), sum.limbs.end(), 0);
+    std::fill(sum.carries.begin(), sum.carries.end(), 0);
+  }
+}
+
+}  // namespace chalk
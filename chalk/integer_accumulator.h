@@ -0,0 +1,89 @@
+#ifndef CHALK_INTEGER_ACCUMULATOR_H
+#define CHALK_INTEGER_ACCUMULATOR_H
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "chalk/integer.h"
+
+namespace chalk {
+
+// Accumulates a sum of many `Integer` terms, materializing the result only when
+// `value` is called.
+//
+// Adding to an `Integer` propagates carries through the whole sum, normalizes
+// it and may reallocate it, for every term. An accumulator instead holds the
+// positive and negative terms in separate carry-save sums: each limb of a term
+// is added to the corresponding limb of the sum, and the carry out of each
+// limb is counted alongside the sum rather than propagated, so that no limb
+// depends on its neighbour. Carries are resolved and the negative terms
+// subtracted once, by `value`. The buffers grow to the length of the longest
+// term and are never shrunk, so that once they are large enough, adding terms
+// and products of terms does not allocate.
+struct IntegerAccumulator {
+  // Constructs an accumulator holding zero, with room for terms of up to
+  // `limbs` limbs.
+  explicit IntegerAccumulator(size_t limbs = 1);
+
+  IntegerAccumulator &operator+=(Integer const &n);
+  IntegerAccumulator &operator-=(Integer const &n);
+  IntegerAccumulator &operator+=(std::integral auto n) {
+    auto [magnitude, negative] = Integer::SplitSign(n);
+    return AddWord(magnitude, negative);
+  }
+  IntegerAccumulator &operator-=(std::integral auto n) {
+    auto [magnitude, negative] = Integer::SplitSign(n);
+    return AddWord(magnitude, not negative);
+  }
+
+  // Adds or subtracts the product `a * b`, which is formed in a buffer owned
+  // by the accumulator rather than in a temporary `Integer`.
+  IntegerAccumulator &AddMul(Integer const &a, Integer const &b);
+  IntegerAccumulator &SubMul(Integer const &a, Integer const &b);
+  IntegerAccumulator &AddMul(Integer const &a, std::integral auto b) {
+    auto [magnitude, negative] = Integer::SplitSign(b);
+    return AddMulWord(a, magnitude, Integer::IsNegative(a) != negative);
+  }
+  IntegerAccumulator &SubMul(Integer const &a, std::integral auto b) {
+    auto [magnitude, negative] = Integer::SplitSign(b);
+    return AddMulWord(a, magnitude, Integer::IsNegative(a) == negative);
+  }
+
+  // Returns the sum of all terms accumulated so far.
+  Integer value() const;
+
+  // Resets the sum to zero, retaining the buffers.
+  void clear();
+
+ private:
+  // A carry-save sum of terms of one sign, whose value is the sum of `limbs`
+  // and `carries`, where `carries` has one more limb than `limbs` to count the
+  // carries out of the top limb.
+  struct Sum {
+    std::vector<uint64_t> limbs;
+    std::vector<uint64_t> carries;
+  };
+
+  // The number of limbs in each `Sum`, which bounds the length of a term.
+  size_t width() const { return sums_[0].limbs.size(); }
+  void Widen(size_t limbs);
+
+  // Adds `a[0, n)`, negated if `negative` is set, to the sum.
+  IntegerAccumulator &AddLimbs(uint64_t const *a, size_t n, bool negative);
+  IntegerAccumulator &AddWord(uint64_t magnitude, bool negative);
+  IntegerAccumulator &AddMulWord(Integer const &a, uint64_t b,
+                                 bool negative_product);
+  IntegerAccumulator &AddProduct(Integer const &a, Integer const &b,
+                                 bool negative_product);
+
+  // Positive terms are accumulated in `sums_[0]` and negative ones in
+  // `sums_[1]`.
+  Sum sums_[2];
+  std::vector<uint64_t> scratch_;
+};
+
+}  // namespace chalk
+
+#endif  // CHALK_INTEGER_ACCUMULATOR_H
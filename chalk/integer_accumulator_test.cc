@@ -0,0 +1,87 @@
+#include "chalk/integer_accumulator.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "chalk/integer.h"
+#include "gtest/gtest.h"
+
+namespace chalk {
+namespace {
+
+TEST(IntegerAccumulator, Empty) {
+  IntegerAccumulator accumulator;
+  EXPECT_EQ(accumulator.value(), 0);
+}
+
+TEST(IntegerAccumulator, Words) {
+  IntegerAccumulator accumulator;
+  accumulator += 3;
+  accumulator -= 5;
+  EXPECT_EQ(accumulator.value(), -2);
+  accumulator += int64_t{-7};
+  EXPECT_EQ(accumulator.value(), -9);
+  accumulator -= int64_t{-9};
+  EXPECT_EQ(accumulator.value(), 0);
+
+  // Carries out of the only limb are deferred to the next.
+  accumulator.clear();
+  Integer expected = 0;
+  for (int i = 0; i < 100; ++i) {
+    accumulator += ~uint64_t{0};
+    expected += ~uint64_t{0};
+  }
+  EXPECT_EQ(accumulator.value(), expected);
+}
+
+TEST(IntegerAccumulator, Integers) {
+  Integer big = Pow(Integer(3), 1000);
+  IntegerAccumulator accumulator;
+  accumulator += big;
+  EXPECT_EQ(accumulator.value(), big);
+  accumulator -= big;
+  EXPECT_EQ(accumulator.value(), 0);
+  accumulator -= big;
+  accumulator += 1;
+  EXPECT_EQ(accumulator.value(), 1 - big);
+
+  // Terms with every limb saturated carry out of every limb at once.
+  Integer ones = Pow(Integer(2), 64 * 20) - 1;
+  accumulator.clear();
+  Integer expected = 0;
+  for (int i = 0; i < 50; ++i) {
+    accumulator += ones;
+    accumulator -= -ones;
+    expected += 2 * ones;
+  }
+  accumulator -= Integer(1);
+  expected -= 1;
+  EXPECT_EQ(accumulator.value(), expected);
+}
+
+TEST(IntegerAccumulator, Products) {
+  std::vector<Integer> values = {
+      0, 1, -1, 17, -Pow(Integer(7), 30), Pow(Integer(5), 400),
+      -Pow(Integer(11), 2000)};
+  IntegerAccumulator accumulator;
+  Integer expected = 0;
+  for (Integer const &a : values) {
+    for (Integer const &b : values) {
+      accumulator.AddMul(a, b);
+      expected += a * b;
+      accumulator.SubMul(a, b * 3);
+      expected -= a * b * 3;
+      accumulator.AddMul(a, int64_t{-12345});
+      expected += a * -12345;
+      accumulator.SubMul(b, uint64_t{98765});
+      expected -= b * uint64_t{98765};
+    }
+  }
+  EXPECT_EQ(accumulator.value(), expected);
+  accumulator.AddMul(values.back(), values.back());
+  expected += values.back() * values.back();
+  EXPECT_EQ(accumulator.value(), expected);
+}
+
+}  // namespace
+}  // namespace chalk
@@ -0,0 +1,121 @@
+#include "chalk/integer_executor.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace chalk {
+namespace {
+
+struct SerialExecutor final : IntegerExecutor {
+  void Run(size_t n, absl::FunctionRef<void(size_t)> task) override {
+    for (size_t i = 0; i < n; ++i) { task(i); }
+  }
+  size_t concurrency() const override { return 1; }
+};
+
+IntegerExecutor *&ThreadCurrentExecutor() {
+  thread_local IntegerExecutor *executor = &SerialIntegerExecutor();
+  return executor;
+}
+
+}  // namespace
+
+IntegerExecutor &SerialIntegerExecutor() {
+  static SerialExecutor executor;
+  return executor;
+}
+
+IntegerExecutor &CurrentIntegerExecutor() { return *ThreadCurrentExecutor(); }
+
+ScopedIntegerExecutor::ScopedIntegerExecutor(IntegerExecutor &executor)
+    : previous_(ThreadCurrentExecutor()) {
+  ThreadCurrentExecutor() = &executor;
+}
+
+ScopedIntegerExecutor::~ScopedIntegerExecutor() {
+  ThreadCurrentExecutor() = previous_;
+}
+
+// The tasks of one call to `Run`. Any thread may claim the next unclaimed
+// index. A batch stays alive until every thread that saw it has let go, but
+// `task` is only called while `Run` is waiting for it.
+struct ThreadPoolIntegerExecutor::Batch {
+  Batch(size_t n, absl::FunctionRef<void(size_t)> task)
+      : n(n), remaining(n), task(task) {}
+
+  bool exhausted() const { return next.load(std::memory_order_relaxed) >= n; }
+
+  // Runs unclaimed tasks until there are none left.
+  void Work() {
+    for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < n;) {
+      task(i);
+      if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard lock(mutex);
+        done.notify_all();
+      }
+    }
+  }
+
+  size_t const n;
+  std::atomic<size_t> next = 0;
+  std::atomic<size_t> remaining;
+  absl::FunctionRef<void(size_t)> task;
+  std::mutex mutex;
+  std::condition_variable done;
+};
+
+ThreadPoolIntegerExecutor::ThreadPoolIntegerExecutor(size_t threads) {
+  threads = std::max<size_t>(threads, 1);
+  workers_.reserve(threads - 1);
+  for (size_t i = 1; i < threads; ++i) {
+    workers_.emplace_back([this] { Work(); });
+  }
+}
+
+ThreadPoolIntegerExecutor::~ThreadPoolIntegerExecutor() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  ready_.notify_all();
+  for (std::thread &worker : workers_) { worker.join(); }
+}
+
+void ThreadPoolIntegerExecutor::Run(size_t n,
+                                    absl::FunctionRef<void(size_t)> task) {
+  if (n <= 1 or workers_.empty()) {
+    for (size_t i = 0; i < n; ++i) { task(i); }
+    return;
+  }
+  auto batch = std::make_shared<Batch>(n, task);
+  {
+    std::lock_guard lock(mutex_);
+    batches_.push_back(batch);
+  }
+  ready_.notify_all();
+  batch->Work();
+  std::unique_lock lock(batch->mutex);
+  batch->done.wait(lock, [&] {
+    return batch->remaining.load(std::memory_order_acquire) == 0;
+  });
+}
+
+void ThreadPoolIntegerExecutor::Work() {
+  while (true) {
+    std::shared_ptr<Batch> batch;
+    {
+      std::unique_lock lock(mutex_);
+      ready_.wait(lock, [&] { return stopping_ or not batches_.empty(); });
+      if (stopping_) { return; }
+      batch = batches_.front();
+      // Once every task of a batch is claimed, no other thread needs it.
+      if (batch->exhausted()) {
+        batches_.pop_front();
+        continue;
+      }
+    }
+    batch->Work();
+  }
+}
+
+}  // namespace chalk
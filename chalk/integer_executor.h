@@ -0,0 +1,84 @@
+#ifndef CHALK_INTEGER_EXECUTOR_H
+#define CHALK_INTEGER_EXECUTOR_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+
+namespace chalk {
+
+// A policy for running the independent pieces of a single very large `Integer`
+// operation concurrently. Operations split their work into pieces that do not
+// depend on how, or whether, the pieces are run concurrently, so results are
+// identical under every executor.
+struct IntegerExecutor {
+  virtual ~IntegerExecutor() = default;
+
+  // Calls `task(i)` for each `i` in `[0, n)`, possibly concurrently and in any
+  // order, and returns once every call has completed. Tasks may themselves
+  // call `Run`.
+  virtual void Run(size_t n, absl::FunctionRef<void(size_t)> task) = 0;
+
+  // Returns the number of tasks that may usefully run at once.
+  virtual size_t concurrency() const = 0;
+};
+
+// Returns the executor used unless another is installed with
+// `ScopedIntegerExecutor`, which runs every task on the calling thread, in
+// order.
+IntegerExecutor &SerialIntegerExecutor();
+
+// Returns the executor used by `Integer` operations on the calling thread.
+IntegerExecutor &CurrentIntegerExecutor();
+
+// Installs `executor` as the calling thread's current executor for the
+// lifetime of this object, restoring the previous executor afterwards. Scopes
+// may be nested but must be destroyed in the reverse order of construction.
+struct ScopedIntegerExecutor {
+  explicit ScopedIntegerExecutor(IntegerExecutor &executor);
+  ScopedIntegerExecutor(ScopedIntegerExecutor const &)            = delete;
+  ScopedIntegerExecutor &operator=(ScopedIntegerExecutor const &) = delete;
+  ~ScopedIntegerExecutor();
+
+ private:
+  IntegerExecutor *previous_;
+};
+
+// An executor backed by a fixed pool of worker threads. The thread calling
+// `Run` works on its own tasks alongside the pool rather than blocking, so
+// nested calls to `Run` always make progress. A pool may be shared between
+// threads.
+struct ThreadPoolIntegerExecutor final : IntegerExecutor {
+  // Creates a pool of `threads - 1` workers, so that together with the calling
+  // thread up to `threads` tasks run at once.
+  explicit ThreadPoolIntegerExecutor(
+      size_t threads = std::thread::hardware_concurrency());
+  ThreadPoolIntegerExecutor(ThreadPoolIntegerExecutor const &) = delete;
+  ThreadPoolIntegerExecutor &operator=(ThreadPoolIntegerExecutor const &) =
+      delete;
+  ~ThreadPoolIntegerExecutor() override;
+
+  void Run(size_t n, absl::FunctionRef<void(size_t)> task) override;
+  size_t concurrency() const override { return workers_.size() + 1; }
+
+ private:
+  struct Batch;
+
+  void Work();
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<std::shared_ptr<Batch>> batches_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace chalk
+
+#endif  // CHALK_INTEGER_EXECUTOR_H
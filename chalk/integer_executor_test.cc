@@ -0,0 +1,115 @@
+#include "chalk/integer_executor.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "chalk/integer.h"
+#include "chalk/integer_thresholds.h"
+#include "gtest/gtest.h"
+
+namespace chalk {
+namespace {
+
+// Runs tasks on the calling thread in reverse order, claiming a concurrency of
+// eight so that work is split as it would be for a pool, and counts the tasks
+// it is given.
+struct ReversingExecutor final : IntegerExecutor {
+  void Run(size_t n, absl::FunctionRef<void(size_t)> task) override {
+    tasks += n;
+    for (size_t i = n; i-- > 0;) { task(i); }
+  }
+  size_t concurrency() const override { return 8; }
+
+  size_t tasks = 0;
+};
+
+TEST(IntegerExecutor, Scopes) {
+  EXPECT_EQ(&CurrentIntegerExecutor(), &SerialIntegerExecutor());
+  ReversingExecutor outer, inner;
+  {
+    ScopedIntegerExecutor outer_scope(outer);
+    {
+      ScopedIntegerExecutor inner_scope(inner);
+      EXPECT_EQ(&CurrentIntegerExecutor(), &inner);
+      std::thread([] {
+        EXPECT_EQ(&CurrentIntegerExecutor(), &SerialIntegerExecutor());
+      }).join();
+    }
+    EXPECT_EQ(&CurrentIntegerExecutor(), &outer);
+  }
+  EXPECT_EQ(&CurrentIntegerExecutor(), &SerialIntegerExecutor());
+}
+
+TEST(ThreadPoolIntegerExecutor, RunsEveryTaskOnce) {
+  ThreadPoolIntegerExecutor executor(4);
+  EXPECT_EQ(executor.concurrency(), 4u);
+  for (size_t n : {0, 1, 2, 7, 1000}) {
+    std::vector<std::atomic<int>> counts(n);
+    executor.Run(n, [&](size_t i) { ++counts[i]; });
+    for (size_t i = 0; i < n; ++i) { EXPECT_EQ(counts[i], 1) << i; }
+  }
+}
+
+TEST(ThreadPoolIntegerExecutor, NestedRuns) {
+  ThreadPoolIntegerExecutor executor(3);
+  std::atomic<int> total = 0;
+  executor.Run(8, [&](size_t) {
+    executor.Run(8, [&](size_t j) { total += static_cast<int>(j); });
+  });
+  EXPECT_EQ(total, 8 * 28);
+}
+
+TEST(ThreadPoolIntegerExecutor, SharedBetweenThreads) {
+  ThreadPoolIntegerExecutor executor(2);
+  std::atomic<int> total = 0;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 100; ++i) {
+        executor.Run(3, [&](size_t) { ++total; });
+      }
+    });
+  }
+  for (std::thread &thread : threads) { thread.join(); }
+  EXPECT_EQ(total, 4 * 100 * 3);
+}
+
+TEST(IntegerExecutor, ParallelMultiplication) {
+  IntegerThresholds saved = GlobalIntegerThresholds();
+  // Roughly 7400 limbs each, so that each transform has room for several
+  // tasks.
+  Integer a       = Pow(Integer(3), 300000);
+  Integer b       = Pow(Integer(7), 170000) + 1;
+  Integer product = a * b;
+  Integer square  = a * a;
+
+  GlobalIntegerThresholds().ntt_multiplication      = 16;
+  GlobalIntegerThresholds().parallel_multiplication = 16;
+  {
+    ReversingExecutor executor;
+    ScopedIntegerExecutor scope(executor);
+    EXPECT_EQ(a * b, product);
+    EXPECT_EQ(a.Square(), square);
+    EXPECT_GT(executor.tasks, 3u);
+  }
+  {
+    ThreadPoolIntegerExecutor executor(4);
+    ScopedIntegerExecutor scope(executor);
+    EXPECT_EQ(a * b, product);
+    EXPECT_EQ(a.Square(), square);
+    EXPECT_EQ(-a * b, -product);
+  }
+  {
+    // Below the threshold, the executor is not consulted.
+    GlobalIntegerThresholds().parallel_multiplication = 1 << 20;
+    ReversingExecutor executor;
+    ScopedIntegerExecutor scope(executor);
+    EXPECT_EQ(a * b, product);
+    EXPECT_EQ(executor.tasks, 0u);
+  }
+  GlobalIntegerThresholds() = saved;
+}
+
+}  // namespace
+}  // namespace chalk
@@ -1,5 +1,13 @@
 #include "chalk/integer.h"
 
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "chalk/integer_executor.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -12,7 +20,33 @@ Integer Factorial(size_t n) {
   return result;
 }
 
+// Runs each task on a thread of its own, so that no task runs on the thread
+// calling `Run`, and counts the calls from those threads that split a
+// convolution across its three primes.
+struct ThreadPerTaskExecutor final : IntegerExecutor {
+  void Run(size_t n, absl::FunctionRef<void(size_t)> task) override {
+    if (n == 3 and std::this_thread::get_id() != caller) {
+      ++worker_convolutions;
+    }
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < n; ++i) {
+      threads.emplace_back([&task, i] { task(i); });
+    }
+    for (std::thread& thread : threads) { thread.join(); }
+  }
+  size_t concurrency() const override { return 4; }
+
+  std::thread::id caller = std::this_thread::get_id();
+  std::atomic<size_t> worker_convolutions = 0;
+};
+
 std::string ToString(Integer const& n) {
+  std::stringstream ss;
+  ss << std::hex << n;
+  return ss.str();
+}
+
+std::string ToDecimalString(Integer const& n) {
   std::stringstream ss;
   ss << n;
   return ss.str();
@@ -129,6 +163,36 @@ TEST(Integer, CopyMoveConstruction) {
   EXPECT_EQ(-1, Integer(std::move(minus_one)));
 }
 
+TEST(Integer, InlineAndHeapStorage) {
+  Integer two_limbs = Integer(std::numeric_limits<uint64_t>::max()) + 1;
+  Integer big       = Factorial(40);
+  Integer negative_big = -Factorial(40);
+
+  EXPECT_EQ(Integer(two_limbs), two_limbs);
+  EXPECT_EQ(Integer(big), big);
+  EXPECT_EQ(Integer(negative_big), negative_big);
+
+  Integer copy = big;
+  copy         = two_limbs;
+  EXPECT_EQ(copy, two_limbs);
+  copy = negative_big;
+  EXPECT_EQ(copy, negative_big);
+  copy = -1;
+  EXPECT_EQ(copy, -1);
+
+  Integer moved = std::move(copy);
+  EXPECT_EQ(moved, -1);
+  EXPECT_EQ(copy, 0);
+
+  moved = std::move(big);
+  EXPECT_EQ(moved, Factorial(40));
+  EXPECT_EQ(big, 0);
+
+  moved = moved - Factorial(40) + 3;
+  EXPECT_EQ(moved, 3);
+  EXPECT_EQ(Integer(moved), 3);
+}
+
 TEST(Integer, Comparison) {
   Integer minus_one = -1;
   Integer zero      = 0;
@@ -367,6 +431,13 @@ TEST(Integer, AdditionSubtraction) {
 
   EXPECT_EQ(x + y, 0);
   EXPECT_EQ(y + x, 0);
+
+  EXPECT_EQ(ToString(1 - x), "-0x7fffffffffffffff");
+  EXPECT_EQ(ToString(one - (x + x)), "-0xffffffffffffffff");
+  EXPECT_EQ(ToString(x - (x + x)), "-0x8000000000000000");
+  EXPECT_FALSE(Integer::IsNegative(-zero));
+  EXPECT_FALSE(Integer::IsNegative(1 - one));
+  EXPECT_FALSE(Integer::IsNegative(x - Integer(x)));
 }
 
 TEST(Integer, Overflow) {
@@ -385,6 +456,84 @@ TEST(Integer, Overflow) {
   EXPECT_EQ(n, m);
 }
 
+TEST(Integer, WordArithmetic) {
+  int64_t const min = std::numeric_limits<int64_t>::min();
+  Integer n         = min;
+  EXPECT_EQ(ToString(n), "-0x8000000000000000");
+  EXPECT_EQ(n, min);
+  EXPECT_EQ(static_cast<int64_t>(n), min);
+  EXPECT_EQ(static_cast<int32_t>(Integer(-5)), -5);
+  EXPECT_EQ(static_cast<uint8_t>(Integer(200)), 200);
+
+  n += min;
+  EXPECT_EQ(ToString(n), "-0x10000000000000000");
+  n -= min;
+  EXPECT_EQ(n, min);
+  n -= -1;
+  EXPECT_EQ(n, min + 1);
+
+  n = Integer(~uint64_t{0}) + 1;
+  n -= 1;
+  EXPECT_EQ(n, ~uint64_t{0});
+  n = 5;
+  n -= 7u;
+  EXPECT_EQ(n, -2);
+  n += 2;
+  EXPECT_EQ(n, 0);
+  EXPECT_FALSE(Integer::IsNegative(n));
+
+  // Carries and borrows propagating through many limbs.
+  Integer power = Integer(~uint64_t{0}) + 1;
+  power *= power;
+  power *= power;
+  EXPECT_EQ(-power + 1, 1 - power);
+  n = power - 1;
+  n += 1u;
+  EXPECT_EQ(n, power);
+  n -= 1u;
+  EXPECT_EQ(n, power - Integer(1));
+
+  EXPECT_EQ(Factorial(30) * 31u, Factorial(31));
+  EXPECT_EQ(31 * Factorial(30), Factorial(31));
+  EXPECT_EQ(Factorial(30) * -31, -Factorial(31));
+  EXPECT_EQ(Factorial(30) * min, -(Factorial(30) * (uint64_t{1} << 63)));
+  EXPECT_EQ(Factorial(30) * 0, 0);
+  EXPECT_FALSE(Integer::IsNegative(-Factorial(30) * 0));
+
+  EXPECT_EQ(Factorial(31) / 31, Factorial(30));
+  EXPECT_EQ(Factorial(31) / -31, -Factorial(30));
+  EXPECT_EQ(-Factorial(31) / 31u, -Factorial(30));
+  EXPECT_EQ(Integer(-7) / 2, -3);
+  EXPECT_EQ((Factorial(31) + 5) % 31, 5);
+  EXPECT_EQ((-Factorial(31) - 5) % 31, -5);
+  EXPECT_EQ(Integer(-7) % -2, -1);
+  EXPECT_EQ(Integer(-8) % 2, 0);
+  EXPECT_FALSE(Integer::IsNegative(Integer(-8) % 2));
+  n = Factorial(25);
+  n /= 25;
+  EXPECT_EQ(n, Factorial(24));
+  n %= 1000;
+  EXPECT_EQ(n, 0);
+}
+
+TEST(Integer, WordComparison) {
+  Integer big = Integer(~uint64_t{0}) + 1;
+  EXPECT_TRUE(big > 1u);
+  EXPECT_TRUE(big > ~uint64_t{0});
+  EXPECT_FALSE(big < 1u);
+  EXPECT_TRUE(Integer(2) < 3u);
+  EXPECT_FALSE(Integer(3) < 3u);
+  EXPECT_TRUE(Integer(-1) < 0u);
+  EXPECT_TRUE(0u > Integer(-1));
+  EXPECT_FALSE(0u < -big);
+  EXPECT_TRUE(-big < std::numeric_limits<int64_t>::min());
+  EXPECT_TRUE(Integer(std::numeric_limits<int64_t>::min()) <= -1);
+  EXPECT_TRUE(Integer(-5) == -5);
+  EXPECT_TRUE(-5 == Integer(-5));
+  EXPECT_FALSE(Integer(5) == -5);
+  EXPECT_FALSE(big == 0);
+}
+
 TEST(Integer, Factorial) {
   EXPECT_EQ(ToString(Factorial(0)), "0x1");
   EXPECT_EQ(ToString(Factorial(1)), "0x1");
@@ -490,6 +639,667 @@ TEST(Integer, Factorial) {
 TEST(Integer, Multiplication) {
   EXPECT_EQ(Integer(2) * Integer(5), 10);
   EXPECT_EQ(Integer(2) * Integer(5), Integer(10));
+  EXPECT_EQ(Integer(-2) * Integer(5), -10);
+  EXPECT_EQ(Integer(-2) * Integer(-5), 10);
+  EXPECT_EQ(Integer(0) * Integer(-5), 0);
+  EXPECT_FALSE(Integer::IsNegative(Integer(0) * Integer(-5)));
+}
+
+Integer RangeProduct(size_t low, size_t high) {
+  Integer result = 1;
+  for (size_t i = low; i <= high; ++i) { result *= i; }
+  return result;
+}
+
+TEST(Integer, LargeMultiplication) {
+  // Products of these sizes exercise the Karatsuba and Toom-3 algorithms with
+  // the default thresholds.
+  for (size_t n : {400, 1200, 3000}) {
+    Integer lower = RangeProduct(1, n / 2);
+    Integer upper = RangeProduct(n / 2 + 1, n);
+    EXPECT_EQ(lower * upper, Factorial(n));
+    EXPECT_EQ(upper * lower, Factorial(n));
+    EXPECT_EQ(-lower * upper, -Factorial(n));
+    EXPECT_EQ(Factorial(n / 3) * upper * lower, Factorial(n / 3) * Factorial(n));
+  }
+}
+
+TEST(Integer, TransformMultiplication) {
+  IntegerThresholds saved = GlobalIntegerThresholds();
+  Integer lower           = RangeProduct(1, 1500);
+  Integer upper           = RangeProduct(1501, 3000);
+  Integer expected        = lower * upper;
+
+  GlobalIntegerThresholds().ntt_multiplication = 16;
+  EXPECT_EQ(lower * upper, expected);
+  EXPECT_EQ(upper * -lower, -expected);
+  EXPECT_EQ(Factorial(3000), expected);
+  GlobalIntegerThresholds() = saved;
+}
+
+TEST(Integer, Squaring) {
+  EXPECT_EQ(Integer(0).Square(), 0);
+  EXPECT_EQ(Integer(-3).Square(), 9);
+  EXPECT_FALSE(Integer::IsNegative(Integer(-3).Square()));
+
+  for (size_t n : {1, 20, 100, 1000, 3000}) {
+    Integer value    = -RangeProduct(n / 2, n);
+    Integer copy     = value;
+    Integer expected = value * copy;
+    EXPECT_EQ(value.Square(), expected) << "n = " << n;
+    EXPECT_EQ(value * value, expected) << "n = " << n;
+    EXPECT_FALSE(Integer::IsNegative(value * value));
+    value *= value;
+    EXPECT_EQ(value, expected) << "n = " << n;
+  }
+}
+
+TEST(Integer, Pow) {
+  EXPECT_EQ(Pow(Integer(0), 0), 1);
+  EXPECT_EQ(Pow(Integer(0), 7), 0);
+  EXPECT_EQ(Pow(Integer(-2), 0), 1);
+  EXPECT_EQ(Pow(Integer(-2), 63), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(Pow(Integer(-2), 64), Integer(~uint64_t{0}) + 1);
+  EXPECT_EQ(Pow(Integer(1), ~uint64_t{0}), 1);
+  EXPECT_EQ(Pow(Integer(-1), ~uint64_t{0}), -1);
+
+  for (uint64_t exponent : {1, 2, 5, 17, 64, 200}) {
+    Integer base     = -Factorial(30) - 1;
+    Integer expected = 1;
+    for (uint64_t i = 0; i < exponent; ++i) { expected *= base; }
+    EXPECT_EQ(Pow(base, exponent), expected) << "exponent = " << exponent;
+  }
+}
+
+TEST(Integer, Sqrt) {
+  EXPECT_EQ(Sqrt(Integer(0)), 0);
+  EXPECT_EQ(Sqrt(Integer(1)), 1);
+  EXPECT_EQ(Sqrt(Integer(99)), 9);
+  EXPECT_EQ(Sqrt(Integer(100)), 10);
+  EXPECT_EQ(Sqrt(Integer(~uint64_t{0})), 0xffffffff);
+
+  for (size_t n : {10, 100, 1000, 3000}) {
+    Integer root   = Factorial(n) + 7;
+    Integer square = root * root;
+    EXPECT_EQ(Sqrt(square), root) << "n = " << n;
+    EXPECT_EQ(Sqrt(square - 1), root - 1) << "n = " << n;
+    EXPECT_EQ(Sqrt(square + 2 * root), root) << "n = " << n;
+  }
+}
+
+TEST(Integer, RootRem) {
+  EXPECT_EQ(RootRem(Integer(0), 3), std::pair(Integer(0), Integer(0)));
+  EXPECT_EQ(RootRem(Integer(30), 3), std::pair(Integer(3), Integer(3)));
+  EXPECT_EQ(RootRem(Integer(-30), 3), std::pair(Integer(-3), Integer(-3)));
+  EXPECT_EQ(RootRem(Integer(-30), 1), std::pair(Integer(-30), Integer(0)));
+  EXPECT_EQ(RootRem(Integer(1000), 2), std::pair(Integer(31), Integer(39)));
+
+  for (uint64_t k : {2, 3, 7, 64, 1000}) {
+    for (Integer n : {Factorial(50), -Factorial(333) - 1, Factorial(2000)}) {
+      if (k % 2 == 0 and n < 0) { continue; }
+      auto [root, remainder] = RootRem(n, k);
+      EXPECT_EQ(Pow(root, k) + remainder, n) << "k = " << k;
+      Integer magnitude = n < 0 ? -n : n;
+      Integer next      = root < 0 ? 1 - root : root + 1;
+      EXPECT_EQ(Integer::IsNegative(remainder), Integer::IsNegative(n));
+      EXPECT_GT(Pow(next, k), magnitude) << "k = " << k;
+    }
+  }
+}
+
+TEST(Integer, ProductOf) {
+  EXPECT_EQ(ProductOf(std::vector<uint64_t>{}), 1);
+  EXPECT_EQ(ProductOf(std::vector<Integer>{}), 1);
+  EXPECT_EQ(ProductOf(std::vector<uint64_t>{7}), 7);
+  EXPECT_EQ(ProductOf(std::vector<uint64_t>{3, 0, 5}), 0);
+  EXPECT_EQ(ProductOf(std::vector<Integer>{Integer(-3), Integer(5)}), -15);
+
+  std::vector<uint64_t> words;
+  Integer expected = 1;
+  for (uint64_t i = 1; i <= 20000; ++i) {
+    // Mix small factors, which pack into words, with full-width ones.
+    uint64_t factor = i % 7 == 0 ? ~uint64_t{0} - i : i;
+    words.push_back(factor);
+    expected *= factor;
+  }
+  EXPECT_EQ(ProductOf(words), expected);
+  Integer word_product = expected;
+
+  // Factors of very different lengths, which split by limbs rather than by
+  // count.
+  std::vector<Integer> factors;
+  expected = 1;
+  for (uint64_t n : {1, 2000, 3, 1, 500, 40, 7000, 2, 2}) {
+    factors.push_back(-Pow(Integer(3), 64 * n) - 1);
+    expected *= factors.back();
+  }
+  EXPECT_EQ(ProductOf(factors), expected);
+
+  // Subtrees run concurrently on the current executor.
+  for (size_t threads : {2, 3, 16}) {
+    ThreadPoolIntegerExecutor pool(threads);
+    ScopedIntegerExecutor scope(pool);
+    EXPECT_EQ(ProductOf(words), word_product) << "threads = " << threads;
+    EXPECT_EQ(ProductOf(factors), expected) << "threads = " << threads;
+  }
+}
+
+TEST(Integer, ProductOfNestedParallelProducts) {
+  // Each half of the tree multiplies two factors of about 16800 limbs, above
+  // the threshold for parallel multiplication, on a thread other than the
+  // caller.
+  std::vector<Integer> factors;
+  Integer expected = 1;
+  for (uint64_t n = 1; n <= 4; ++n) {
+    factors.push_back(Pow(Integer(3), 40 * 17000) + n);
+    expected *= factors.back();
+  }
+  ThreadPerTaskExecutor executor;
+  ScopedIntegerExecutor scope(executor);
+  EXPECT_EQ(ProductOf(factors), expected);
+  EXPECT_GE(executor.worker_convolutions, 2);
+}
+
+TEST(Integer, Division) {
+  EXPECT_EQ(Integer(7) / Integer(2), 3);
+  EXPECT_EQ(Integer(-7) / Integer(2), -3);
+  EXPECT_EQ(Integer(7) / Integer(-2), -3);
+  EXPECT_EQ(Integer(-7) / Integer(-2), 3);
+  EXPECT_EQ(Integer(7) % Integer(2), 1);
+  EXPECT_EQ(Integer(-7) % Integer(2), -1);
+  EXPECT_EQ(Integer(7) % Integer(-2), 1);
+  EXPECT_EQ(Integer(-7) % Integer(-2), -1);
+  EXPECT_EQ(Integer(1) / Integer(2), 0);
+  EXPECT_EQ(Integer(-1) % Integer(2), -1);
+  EXPECT_FALSE(Integer::IsNegative(Integer(-1) / Integer(2)));
+  EXPECT_FALSE(Integer::IsNegative(Integer(-4) % Integer(2)));
+
+  for (size_t n : {20, 21, 30, 100, 500}) {
+    for (size_t m : {1, 2, 19, 20, 21, 45}) {
+      if (m > n) { continue; }
+      EXPECT_EQ(Factorial(n) / Factorial(m), RangeProduct(m + 1, n));
+      EXPECT_EQ(Factorial(n) % Factorial(m), 0);
+    }
+  }
+
+  Integer a = Factorial(60) + 12345;
+  Integer b = Factorial(35) - 1;
+  auto [quotient, remainder] = DivMod(a, b);
+  EXPECT_EQ(quotient * b + remainder, a);
+  EXPECT_TRUE(remainder >= 0);
+  EXPECT_TRUE(remainder < b);
+  EXPECT_EQ(a / b, quotient);
+  EXPECT_EQ(a % b, remainder);
+  EXPECT_EQ(-a / b, -quotient);
+  EXPECT_EQ(-a % b, -remainder);
+  EXPECT_EQ(DivMod(b, a).first, 0);
+  EXPECT_EQ(DivMod(b, a).second, b);
+
+  Integer c = a;
+  c /= b;
+  EXPECT_EQ(c, quotient);
+  c = a;
+  c %= b;
+  EXPECT_EQ(c, remainder);
+}
+
+TEST(Integer, LargeDivision) {
+  // Divisors of these sizes exercise recursive division with the default
+  // thresholds.
+  for (size_t n : {1500, 4000}) {
+    Integer lower = RangeProduct(1, n / 2);
+    Integer upper = RangeProduct(n / 2 + 1, n);
+    Integer whole = lower * upper;
+    EXPECT_EQ(whole / lower, upper);
+    EXPECT_EQ(whole / upper, lower);
+    EXPECT_EQ((whole + upper - 1) / upper, lower);
+    EXPECT_EQ((whole - 1) % upper, upper - 1);
+    EXPECT_EQ(-whole / -lower, upper);
+
+    Integer divisor            = RangeProduct(n / 3, n / 2) + 7;
+    auto [quotient, remainder] = DivMod(whole, divisor);
+    EXPECT_EQ(quotient * divisor + remainder, whole);
+    EXPECT_TRUE(remainder >= 0);
+    EXPECT_TRUE(remainder < divisor);
+  }
+}
+
+TEST(Integer, DivExact) {
+  EXPECT_EQ(DivExact(Integer(0), Integer(5)), 0);
+  EXPECT_EQ(DivExact(Integer(-42), Integer(6)), -7);
+  EXPECT_EQ(DivExact(Integer(42), Integer(-7)), -6);
+  EXPECT_EQ(DivExactByWord(Integer(0), 3), 0);
+  EXPECT_EQ(DivExactByWord(Integer(-42), 6), -7);
+  EXPECT_EQ(DivExactByWord(Integer(42), int64_t{-14}), -3);
+
+  for (size_t n : {30, 300, 3000}) {
+    Integer lower = RangeProduct(1, n / 2);
+    Integer upper = RangeProduct(n / 2 + 1, n);
+    Integer whole = lower * upper;
+    EXPECT_EQ(DivExact(whole, lower), upper);
+    EXPECT_EQ(DivExact(whole, upper), lower);
+    EXPECT_EQ(DivExact(-whole, upper), -lower);
+    EXPECT_EQ(DivExact(whole, whole), 1);
+    EXPECT_EQ(DivExactByWord(whole, uint64_t{n}), whole / n);
+    EXPECT_EQ(DivExactByWord(whole, uint64_t{1} << 10), whole / 1024);
+    EXPECT_EQ(DivExactByWord(-whole, int64_t{-3}), whole / 3);
+  }
+}
+
+TEST(Integer, DivisionByWord) {
+  Integer n = Pow(Integer(3), 2000) + 12345;
+  for (uint64_t d : {uint64_t{1}, uint64_t{7}, uint64_t{1} << 32,
+                     uint64_t{1} << 63, ~uint64_t{0}}) {
+    Integer quotient  = n / d;
+    Integer remainder = n % d;
+    EXPECT_EQ(quotient * d + remainder, n);
+    EXPECT_TRUE(remainder >= 0);
+    EXPECT_TRUE(remainder < d);
+    EXPECT_EQ(n / Integer(d), quotient);
+  }
+}
+
+// Returns the Fibonacci numbers `F(0)` through `F(n)`, for which
+// `Gcd(F(i), F(j)) == F(Gcd(i, j))`.
+std::vector<Integer> FibonacciNumbers(size_t n) {
+  std::vector<Integer> result = {0, 1};
+  while (result.size() <= n) {
+    result.push_back(result[result.size() - 1] + result[result.size() - 2]);
+  }
+  return result;
+}
+
+// Checks the Bezout identity and the bounds on the coefficients.
+void ExpectValidExtendedGcd(Integer const &a, Integer const &b) {
+  auto [g, x, y] = ExtendedGcd(a, b);
+  EXPECT_EQ(g, Gcd(a, b));
+  EXPECT_EQ(a * x + b * y, g);
+  if (a != 0 and b != 0) {
+    Integer abs_a = a < 0 ? -a : a;
+    Integer abs_b = b < 0 ? -b : b;
+    EXPECT_TRUE((x < 0 ? -x : x) * g <= abs_b);
+    EXPECT_TRUE((y < 0 ? -y : y) * g <= abs_a);
+  }
+}
+
+TEST(Integer, Shifts) {
+  EXPECT_EQ(Integer(0) << 100, 0);
+  EXPECT_EQ(Integer(3) << 0, 3);
+  EXPECT_EQ(Integer(3) << 1, 6);
+  EXPECT_EQ(Integer(-3) << 64, -3 * Pow(Integer(2), 64));
+  EXPECT_EQ(Integer(5) << 130, 5 * Pow(Integer(2), 130));
+  EXPECT_EQ(Factorial(40) << 77, Factorial(40) * Pow(Integer(2), 77));
+
+  EXPECT_EQ(Integer(7) >> 1, 3);
+  EXPECT_EQ(Integer(-7) >> 1, -4);
+  EXPECT_EQ(Integer(-8) >> 1, -4);
+  EXPECT_EQ(Integer(-1) >> 1000, -1);
+  EXPECT_EQ(Integer(12345) >> 1000, 0);
+  EXPECT_EQ(Factorial(40) >> 64, Factorial(40) / Pow(Integer(2), 64));
+  EXPECT_EQ(Factorial(40) >> 70, Factorial(40) / Pow(Integer(2), 70));
+  // `-(2^128)` shifted right by 128 is exact, but by 127 is not.
+  Integer power = Pow(Integer(2), 128);
+  EXPECT_EQ(-power >> 128, -1);
+  EXPECT_EQ((-power - 1) >> 128, -2);
+  EXPECT_EQ((-power + 1) >> 127, -2);
+
+  for (int64_t n : {int64_t{0}, int64_t{1}, int64_t{-1}, int64_t{12345},
+                    int64_t{-12345}, std::numeric_limits<int64_t>::min()}) {
+    for (int shift : {1, 5, 31, 63}) {
+      EXPECT_EQ(Integer(n) >> shift, n >> shift) << n << " >> " << shift;
+    }
+  }
+
+  Integer n = Factorial(100);
+  n <<= 1000;
+  n >>= 1000;
+  EXPECT_EQ(n, Factorial(100));
+}
+
+TEST(Integer, BitwiseMatchesMachineWords) {
+  std::vector<int64_t> values = {0,  1,    -1,   2,  -2,    7,
+                                 -8, 1000, -999, 64, -4096, 0x5a5a5a5a};
+  for (int64_t a : values) {
+    for (int64_t b : values) {
+      EXPECT_EQ(Integer(a) & Integer(b), a & b) << a << " & " << b;
+      EXPECT_EQ(Integer(a) | Integer(b), a | b) << a << " | " << b;
+      EXPECT_EQ(Integer(a) ^ Integer(b), a ^ b) << a << " ^ " << b;
+    }
+    EXPECT_EQ(~Integer(a), ~a);
+  }
+}
+
+TEST(Integer, BitwiseMultipleLimbs) {
+  // 60! lies between 2^271 and 2^272.
+  Integer big      = Factorial(60);
+  Integer power    = Pow(Integer(2), 300);
+  Integer low_bits = Pow(Integer(2), 200) - 1;
+  EXPECT_EQ(big & low_bits, big % (low_bits + 1));
+  EXPECT_EQ(big & ~low_bits, big - big % (low_bits + 1));
+  EXPECT_EQ(big & -power, 0);
+  EXPECT_EQ((big + power) & -power, power);
+  EXPECT_EQ(big | power, big + power);
+  EXPECT_EQ(big ^ big, 0);
+  EXPECT_EQ(big ^ -1, ~big);
+  EXPECT_EQ(-big & -1, -big);
+  EXPECT_EQ(-big | 0, -big);
+  // The lowest set bit.
+  EXPECT_EQ(big & -big, Pow(Integer(2), CountTrailingZeros(big)));
+  // A negative result whose magnitude needs a limb more than either operand.
+  Integer low = Pow(Integer(2), 128) - 1;
+  EXPECT_EQ(-Pow(Integer(2), 128) | low, -1);
+  EXPECT_EQ(-Pow(Integer(2), 128) & -Pow(Integer(2), 127),
+            -Pow(Integer(2), 128));
+  EXPECT_EQ((-low) ^ low, -2);
+
+  Integer n = big;
+  n &= n;
+  EXPECT_EQ(n, big);
+  n |= n;
+  EXPECT_EQ(n, big);
+  n ^= n;
+  EXPECT_EQ(n, 0);
+}
+
+TEST(Integer, BitCounts) {
+  EXPECT_EQ(BitLength(Integer(0)), 0);
+  EXPECT_EQ(BitLength(Integer(1)), 1);
+  EXPECT_EQ(BitLength(Integer(-255)), 8);
+  EXPECT_EQ(BitLength(Pow(Integer(2), 200)), 201);
+  EXPECT_EQ(BitLength(Pow(Integer(2), 200) - 1), 200);
+
+  EXPECT_EQ(PopCount(Integer(0)), 0);
+  EXPECT_EQ(PopCount(Integer(-255)), 8);
+  EXPECT_EQ(PopCount(Pow(Integer(2), 200) - 1), 200);
+
+  EXPECT_EQ(CountTrailingZeros(Integer(1)), 0);
+  EXPECT_EQ(CountTrailingZeros(Integer(-96)), 5);
+  EXPECT_EQ(CountTrailingZeros(3 * Pow(Integer(2), 150)), 150);
+}
+
+TEST(Integer, BitExtraction) {
+  Integer n = Pow(Integer(2), 100) + 5;
+  EXPECT_TRUE(TestBit(n, 0));
+  EXPECT_FALSE(TestBit(n, 1));
+  EXPECT_TRUE(TestBit(n, 100));
+  EXPECT_FALSE(TestBit(n, 1000));
+  // `-4` is ...11100 in two's complement.
+  EXPECT_FALSE(TestBit(Integer(-4), 1));
+  EXPECT_TRUE(TestBit(Integer(-4), 2));
+  EXPECT_TRUE(TestBit(Integer(-4), 1000));
+  EXPECT_TRUE(TestBit(-Pow(Integer(2), 128), 128));
+  EXPECT_FALSE(TestBit(-Pow(Integer(2), 128), 127));
+
+  EXPECT_EQ(ExtractBits(n, 0, 4), 5);
+  EXPECT_EQ(ExtractBits(n, 98, 4), 4);
+  EXPECT_EQ(ExtractBits(n, 60, 64), uint64_t{1} << 40);
+  EXPECT_EQ(ExtractBits(Integer(-1), 37, 64), ~uint64_t{0});
+  EXPECT_EQ(ExtractBits(Integer(-4), 0, 8), 0xfc);
+  EXPECT_EQ(ExtractBits(-Pow(Integer(2), 128), 120, 16), 0xff00);
+  EXPECT_EQ(ExtractBits(n, 5, 0), 0);
+}
+
+TEST(Integer, Gcd) {
+  EXPECT_EQ(Gcd(Integer(12), Integer(18)), 6);
+  EXPECT_EQ(Gcd(Integer(-12), Integer(18)), 6);
+  EXPECT_EQ(Gcd(Integer(12), Integer(-18)), 6);
+  EXPECT_EQ(Gcd(Integer(-12), Integer(-18)), 6);
+  EXPECT_EQ(Gcd(Integer(0), Integer(-5)), 5);
+  EXPECT_EQ(Gcd(Integer(-5), Integer(0)), 5);
+  EXPECT_EQ(Gcd(Integer(0), Integer(0)), 0);
+  EXPECT_EQ(Gcd(Factorial(100), Factorial(60)), Factorial(60));
+  EXPECT_EQ(Gcd(-Factorial(60), Factorial(100) + 1), 1);
+
+  std::vector<Integer> fibonacci = FibonacciNumbers(2000);
+  for (size_t i : {12, 100, 999, 1000, 2000}) {
+    for (size_t j : {1, 6, 40, 500, 1998}) {
+      EXPECT_EQ(Gcd(fibonacci[i], fibonacci[j]), fibonacci[std::gcd(i, j)])
+          << "i = " << i << ", j = " << j;
+    }
+  }
+}
+
+TEST(Integer, ExtendedGcd) {
+  for (int a : {0, 1, -1, 12, -12, 35}) {
+    for (int b : {0, 1, -1, 18, -18, 35}) {
+      ExpectValidExtendedGcd(a, b);
+    }
+  }
+
+  ExpectValidExtendedGcd(Factorial(100), Factorial(60) + 1);
+  ExpectValidExtendedGcd(-Factorial(80), RangeProduct(30, 90));
+  std::vector<Integer> fibonacci = FibonacciNumbers(2000);
+  ExpectValidExtendedGcd(fibonacci[2000], fibonacci[1999]);
+  ExpectValidExtendedGcd(-fibonacci[1999], fibonacci[2000]);
+  ExpectValidExtendedGcd(fibonacci[1000], -fibonacci[1500]);
+}
+
+TEST(Integer, LargeGcd) {
+  // A low threshold exercises the recursive half-gcd on moderately sized
+  // values.
+  IntegerThresholds saved            = GlobalIntegerThresholds();
+  GlobalIntegerThresholds().half_gcd = 8;
+
+  std::vector<Integer> fibonacci = FibonacciNumbers(30000);
+  EXPECT_EQ(Gcd(fibonacci[30000], fibonacci[29997]), 2);
+  EXPECT_EQ(Gcd(fibonacci[30000], fibonacci[24000]), fibonacci[6000]);
+  ExpectValidExtendedGcd(fibonacci[30000], fibonacci[29999]);
+  ExpectValidExtendedGcd(fibonacci[30000], -fibonacci[18000]);
+
+  Integer common = RangeProduct(1, 1000) + 1;
+  Integer a      = common * (RangeProduct(500, 1500) + 3);
+  Integer b      = common * (RangeProduct(700, 1600) + 5);
+  EXPECT_EQ(Gcd(a, b) % common, 0);
+  ExpectValidExtendedGcd(a, b);
+  GlobalIntegerThresholds() = saved;
+}
+
+TEST(Integer, Lcm) {
+  EXPECT_EQ(Lcm(Integer(4), Integer(6)), 12);
+  EXPECT_EQ(Lcm(Integer(-4), Integer(6)), 12);
+  EXPECT_EQ(Lcm(Integer(4), Integer(-6)), 12);
+  EXPECT_EQ(Lcm(Integer(0), Integer(6)), 0);
+  EXPECT_EQ(Lcm(Integer(-4), Integer(0)), 0);
+  EXPECT_EQ(Lcm(Factorial(60), Factorial(100)), Factorial(100));
+
+  std::vector<Integer> fibonacci = FibonacciNumbers(500);
+  for (size_t i : {30, 200, 500}) {
+    for (size_t j : {12, 100, 301}) {
+      EXPECT_EQ(Lcm(fibonacci[i], fibonacci[j]) * fibonacci[std::gcd(i, j)],
+                fibonacci[i] * fibonacci[j]);
+    }
+  }
+}
+
+TEST(Integer, DecimalOutput) {
+  EXPECT_EQ(ToDecimalString(0), "0");
+  EXPECT_EQ(ToDecimalString(7), "7");
+  EXPECT_EQ(ToDecimalString(-7), "-7");
+  EXPECT_EQ(ToDecimalString(Integer(~uint64_t{0})), "18446744073709551615");
+  EXPECT_EQ(ToDecimalString(Integer(~uint64_t{0}) + 1),
+            "18446744073709551616");
+  EXPECT_EQ(ToDecimalString(Integer(10'000'000'000'000'000'000u)),
+            "10000000000000000000");
+  EXPECT_EQ(ToDecimalString(-Factorial(25)), "-15511210043330985984000000");
+  EXPECT_EQ(ToDecimalString(Factorial(30)),
+            "265252859812191058636308480000000");
+}
+
+TEST(Integer, LargeDecimalOutput) {
+  Integer power = 1;
+  for (int i = 0; i < 2000; ++i) { power *= 10; }
+  EXPECT_EQ(ToDecimalString(power), "1" + std::string(2000, '0'));
+  EXPECT_EQ(ToDecimalString(power - 1), std::string(2000, '9'));
+  EXPECT_EQ(ToDecimalString(-(power - 1)), "-" + std::string(2000, '9'));
+  EXPECT_EQ(ToDecimalString(power * power + 1),
+            "1" + std::string(3999, '0') + "1");
+
+  // The recursive conversion must agree with the schoolbook conversion.
+  IntegerThresholds saved = GlobalIntegerThresholds();
+  Integer n               = -Factorial(1000);
+  GlobalIntegerThresholds().radix_conversion = 1000000;
+  std::string expected                       = ToDecimalString(n);
+  GlobalIntegerThresholds().radix_conversion = 2;
+  EXPECT_EQ(ToDecimalString(n), expected);
+  GlobalIntegerThresholds() = saved;
+}
+
+TEST(Integer, ToChars) {
+  char buffer[64];
+  std::to_chars_result result = ToChars(buffer, buffer + 64, Integer(-1234567));
+  EXPECT_EQ(result.ec, std::errc());
+  EXPECT_EQ(std::string_view(buffer, result.ptr), "-1234567");
+
+  result = ToChars(buffer, buffer + 64, Factorial(25), 16);
+  EXPECT_EQ(result.ec, std::errc());
+  EXPECT_EQ(std::string_view(buffer, result.ptr), "cd4a0619fb0907bc00000");
+
+  // Buffers smaller than `MaxChars` suffice when the value fits.
+  EXPECT_GT(MaxChars(Integer(123)), 3u);
+  result = ToChars(buffer, buffer + 3, Integer(123));
+  EXPECT_EQ(result.ec, std::errc());
+  EXPECT_EQ(std::string_view(buffer, result.ptr), "123");
+
+  result = ToChars(buffer, buffer + 2, Integer(123));
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+  EXPECT_EQ(result.ptr, buffer + 2);
+
+  Integer n = Factorial(200);
+  std::string chars(MaxChars(n), '\0');
+  result = ToChars(chars.data(), chars.data() + chars.size(), n);
+  EXPECT_EQ(result.ec, std::errc());
+  chars.resize(result.ptr - chars.data());
+  EXPECT_EQ(chars, ToDecimalString(n));
+}
+
+TEST(Integer, FromChars) {
+  std::string_view text = "-12345abc";
+  Integer n             = 7;
+  std::from_chars_result result =
+      FromChars(text.data(), text.data() + text.size(), n);
+  EXPECT_EQ(result.ec, std::errc());
+  EXPECT_EQ(result.ptr, text.data() + 6);
+  EXPECT_EQ(n, -12345);
+
+  result = FromChars(text.data() + 1, text.data() + text.size(), n, 16);
+  EXPECT_EQ(result.ec, std::errc());
+  EXPECT_EQ(result.ptr, text.data() + text.size());
+  EXPECT_EQ(n, 0x12345abc);
+
+  for (std::string_view invalid : {"", "-", "+1", "x1", "-a"}) {
+    n      = 7;
+    result = FromChars(invalid.data(), invalid.data() + invalid.size(), n);
+    EXPECT_EQ(result.ec, std::errc::invalid_argument) << invalid;
+    EXPECT_EQ(result.ptr, invalid.data()) << invalid;
+    EXPECT_EQ(n, 7) << invalid;
+  }
+}
+
+TEST(Integer, Parse) {
+  EXPECT_EQ(Integer::Parse("0"), 0);
+  EXPECT_EQ(Integer::Parse("-0"), 0);
+  EXPECT_FALSE(Integer::IsNegative(*Integer::Parse("-0")));
+  EXPECT_EQ(Integer::Parse("000000000000000000000000000000000000042"), 42);
+  EXPECT_EQ(Integer::Parse("18446744073709551616"), Integer(~uint64_t{0}) + 1);
+  EXPECT_EQ(Integer::Parse("-15511210043330985984000000"), -Factorial(25));
+  EXPECT_EQ(Integer::Parse("-0xCD4A0619FB0907BC00000", 16), -Factorial(25));
+  EXPECT_EQ(Integer::Parse("cd4a0619fb0907bc00000", 16), Factorial(25));
+
+  for (std::string_view invalid :
+       {"", "-", "--1", "1 ", " 1", "0x10", "1e5", "+5"}) {
+    EXPECT_EQ(Integer::Parse(invalid), std::nullopt) << invalid;
+  }
+  for (std::string_view invalid : {"0x", "-0x", "0x-1", "g"}) {
+    EXPECT_EQ(Integer::Parse(invalid, 16), std::nullopt) << invalid;
+  }
+}
+
+TEST(Integer, ParseRoundTrip) {
+  for (size_t n : {0, 1, 20, 21, 100, 1000, 3000}) {
+    for (Integer value : {Factorial(n), -Factorial(n), Factorial(n) - 1}) {
+      EXPECT_EQ(Integer::Parse(ToDecimalString(value)), value);
+      EXPECT_EQ(Integer::Parse(ToString(value), 16), value);
+    }
+  }
+
+  Integer power = 1;
+  for (int i = 0; i < 5000; ++i) { power *= 10; }
+  EXPECT_EQ(Integer::Parse("1" + std::string(5000, '0')), power);
+  EXPECT_EQ(Integer::Parse(std::string(5000, '9')), power - 1);
+}
+
+TEST(Integer, AddMul) {
+  std::vector<Integer> values = {0,
+                                 1,
+                                 -1,
+                                 Integer(~uint64_t{0}),
+                                 -Factorial(25),
+                                 Factorial(40),
+                                 Factorial(40) + 1,
+                                 -Factorial(60),
+                                 Factorial(200)};
+  for (Integer const &x : values) {
+    for (Integer const &a : values) {
+      for (Integer const &b : values) {
+        Integer result = x;
+        result.AddMul(a, b);
+        EXPECT_EQ(result, x + a * b);
+        result = x;
+        result.SubMul(a, b);
+        EXPECT_EQ(result, x - a * b);
+      }
+      std::pair<int64_t, Integer> words[] = {
+          {0, 0},
+          {1, 1},
+          {-7, -7},
+          {std::numeric_limits<int64_t>::min(), -Integer(uint64_t{1} << 63)},
+      };
+      for (auto const &[b, expected_b] : words) {
+        Integer result = x;
+        result.AddMul(a, b);
+        EXPECT_EQ(result, x + a * expected_b);
+        result = x;
+        result.SubMul(a, b);
+        EXPECT_EQ(result, x - a * expected_b);
+      }
+      Integer result = x;
+      result.SubMul(a, ~uint64_t{0});
+      EXPECT_EQ(result, x - a * Integer(~uint64_t{0}));
+    }
+  }
+
+  // Cancellation to zero must not leave a negative zero.
+  Integer x = Factorial(30);
+  x.SubMul(Factorial(29), 30);
+  EXPECT_EQ(x, 0);
+  EXPECT_FALSE(Integer::IsNegative(x));
+  x = -Factorial(30);
+  x.AddMul(Factorial(15), RangeProduct(16, 30));
+  EXPECT_EQ(x, 0);
+  EXPECT_FALSE(Integer::IsNegative(x));
+}
+
+TEST(Integer, AddMulAliasing) {
+  Integer x = Factorial(30);
+  x.AddMul(x, x);
+  EXPECT_EQ(x, Factorial(30) + Factorial(30) * Factorial(30));
+  x = Factorial(30);
+  x.SubMul(x, 3);
+  EXPECT_EQ(x, -2 * Factorial(30));
+  x = -Factorial(30);
+  x.SubMul(Factorial(20), x);
+  EXPECT_EQ(x, -Factorial(30) + Factorial(20) * Factorial(30));
+}
+
+TEST(Integer, LargeAddMul) {
+  // Products of these sizes are computed by subquadratic multiplication.
+  Integer a = Factorial(1500);
+  Integer b = RangeProduct(1000, 2500);
+  Integer x = a * b - 1;
+  x.SubMul(a, b);
+  EXPECT_EQ(x, -1);
+  x.AddMul(-a, b);
+  EXPECT_EQ(x, -1 - a * b);
 }
 
 }  // namespace
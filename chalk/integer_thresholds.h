@@ -0,0 +1,63 @@
+#ifndef CHALK_INTEGER_THRESHOLDS_H
+#define CHALK_INTEGER_THRESHOLDS_H
+
+#include <cstddef>
+
+namespace chalk {
+
+// Operand sizes, measured in 64-bit limbs, at which `Integer` arithmetic
+// switches from one algorithm to an asymptotically faster one. The defaults are
+// reasonable on x86-64, but may be tuned for a particular machine. Changing a
+// threshold affects only performance, never results. Thresholds below the
+// smallest operand size an algorithm supports are treated as that minimum.
+struct IntegerThresholds {
+  // Products whose smaller operand has at least this many limbs use Karatsuba
+  // multiplication rather than schoolbook multiplication.
+  size_t karatsuba_multiplication = 32;
+
+  // Squares of at least this many limbs use Karatsuba squaring rather than
+  // schoolbook squaring. Schoolbook squaring computes each cross product only
+  // once, so it remains competitive for longer than schoolbook multiplication.
+  size_t karatsuba_squaring = 80;
+
+  // Products whose smaller operand has at least this many limbs use Toom-3
+  // multiplication rather than Karatsuba multiplication.
+  size_t toom3_multiplication = 128;
+
+  // Products whose smaller operand has at least this many limbs are computed
+  // with number-theoretic transforms rather than Toom-3.
+  size_t ntt_multiplication = 2048;
+
+  // Products whose smaller operand has at least this many limbs split their
+  // number-theoretic transforms into tasks run on `CurrentIntegerExecutor()`,
+  // which runs them on the calling thread unless another executor is
+  // installed.
+  size_t parallel_multiplication = 16384;
+
+  // Divisions whose divisor has at least this many limbs use Burnikel-Ziegler
+  // recursive division, which reduces division to multiplication, rather than
+  // schoolbook long division.
+  size_t burnikel_ziegler_division = 48;
+
+  // Greatest common divisors of values with at least this many limbs reduce
+  // them by a recursive half-gcd, which reduces the computation to
+  // multiplication, rather than by Lehmer's algorithm alone.
+  size_t half_gcd = 2000;
+
+  // Conversions between decimal and values with at least this many limbs split
+  // the value by powers of ten recursively, rather than handling one limb's
+  // worth of digits at a time.
+  size_t radix_conversion = 32;
+};
+
+// Returns the thresholds consulted by all `Integer` arithmetic. Access is not
+// synchronized, so thresholds should only be tuned before `Integer`s are used
+// concurrently.
+inline IntegerThresholds &GlobalIntegerThresholds() {
+  static IntegerThresholds thresholds;
+  return thresholds;
+}
+
+}  // namespace chalk
+
+#endif  // CHALK_INTEGER_THRESHOLDS_H
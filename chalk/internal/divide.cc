@@ -0,0 +1,326 @@
+#include "chalk/internal/divide.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/numeric/int128.h"
+#include "chalk/integer_thresholds.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/multiply.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+// Knuth's Algorithm D (TAOCP Vol. 2, 4.3.1). Divides `u[0, un)` by `v[0, vn)`,
+// writing the low `un - vn` quotient limbs to `q`, returning the high quotient
+// limb (which is zero or one), and leaving the remainder in `u[0, vn)`.
+// Requires `un >= vn >= 2` and that the high bit of `v[vn - 1]` be set.
+uint64_t SchoolbookDivide(uint64_t *q, uint64_t *u, size_t un,
+                          uint64_t const *v, size_t vn) {
+  uint64_t q_high = Compare(u + un - vn, v, vn) >= 0;
+  if (q_high) { SubN(u + un - vn, u + un - vn, v, vn); }
+
+  uint64_t v1 = v[vn - 1];
+  uint64_t v2 = v[vn - 2];
+  for (size_t j = un - vn; j-- > 0;) {
+    uint64_t *window = u + j;
+
+    // Estimate the quotient limb from the leading limbs. The estimate is never
+    // too small, and after the refinement below is at most one too large.
+    uint64_t q_hat, r_hat;
+    bool r_hat_overflow = false;
+    if (window[vn] >= v1) {
+      q_hat          = ~uint64_t{0};
+      r_hat          = window[vn - 1] + v1;
+      r_hat_overflow = r_hat < v1;
+    } else {
+      std::tie(q_hat, r_hat) = DivideLimbs(window[vn], window[vn - 1], v1);
+    }
+    while (not r_hat_overflow) {
+      auto [low, high] = MultiplyLimbs(q_hat, v2);
+      if (high < r_hat or (high == r_hat and low <= window[vn - 2])) { break; }
+      --q_hat;
+      r_hat += v1;
+      r_hat_overflow = r_hat < v1;
+    }
+
+    uint64_t borrow = SubMulOne(window, v, vn, q_hat);
+    uint64_t top    = window[vn];
+    window[vn]      = top - borrow;
+    if (top < borrow) {
+      --q_hat;
+      window[vn] += AddN(window, window, v, vn);
+    }
+    q[j] = q_hat;
+  }
+  return q_high;
+}
+
+uint64_t DivideBalanced(uint64_t *q, uint64_t *u, uint64_t const *v, size_t n,
+                        size_t threshold, uint64_t *scratch);
+
+// Divides `u[0, vn + k)` by `v[0, vn)`, writing the low `k` quotient limbs to
+// `q`, returning the high quotient limb, and leaving the remainder in
+// `u[0, vn)`. Requires `1 <= k <= vn`, that the high bit of `v[vn - 1]` be set,
+// and `scratch` to have room for `vn` limbs.
+//
+// Following Burnikel and Ziegler, the quotient is estimated by recursively
+// dividing the leading `2k` limbs of `u` by the leading `k` limbs of `v`. The
+// estimate is then corrected by subtracting its product with the remaining
+// limbs of `v`, which is computed with fast multiplication. Since `v` is
+// normalized, the estimate is too large by at most a small constant.
+uint64_t DivideBlock(uint64_t *q, uint64_t *u, uint64_t const *v, size_t vn,
+                     size_t k, size_t threshold, uint64_t *scratch) {
+  if (k < threshold) { return SchoolbookDivide(q, u, vn + k, v, vn); }
+  if (k == vn) { return DivideBalanced(q, u, v, vn, threshold, scratch); }
+
+  size_t low_size = vn - k;
+  uint64_t q_high =
+      DivideBalanced(q, u + low_size, v + low_size, k, threshold, scratch);
+
+  Multiply(scratch, q, k, v, low_size);
+  uint64_t borrow = SubN(u, u, scratch, vn);
+  if (q_high) { borrow += SubN(u + k, u + k, v, low_size); }
+  while (borrow != 0) {
+    q_high -= SubOne(q, q, k, 1);
+    borrow -= AddN(u, u, v, vn);
+  }
+  return q_high;
+}
+
+// Divides `u[0, 2n)` by `v[0, n)` as two half-sized blocks, writing the low `n`
+// quotient limbs to `q`, returning the high quotient limb, and leaving the
+// remainder in `u[0, n)`. Requires `n >= threshold >= 4`, that the high bit of
+// `v[n - 1]` be set, and `scratch` to have room for `n` limbs.
+uint64_t DivideBalanced(uint64_t *q, uint64_t *u, uint64_t const *v, size_t n,
+                        size_t threshold, uint64_t *scratch) {
+  size_t low_size  = n / 2;
+  size_t high_size = n - low_size;
+  uint64_t q_high  = DivideBlock(q + low_size, u + low_size, v, n, high_size,
+                                 threshold, scratch);
+  // The remainder of the first block is less than `v`, so the second block's
+  // high quotient limb is always zero.
+  DivideBlock(q, u, v, n, low_size, threshold, scratch);
+  return q_high;
+}
+
+// Divides `u[0, un)` by `v[0, vn)`, writing the `un - vn` quotient limbs to `q`
+// and leaving the remainder in `u[0, vn)`. Requires `un > vn >= threshold`,
+// that the high bit of `v[vn - 1]` be set, and that `u[un - vn, un) < v`. The
+// quotient is produced from the top in blocks of at most `vn` limbs, each
+// taking O(M(vn) log vn) time, where M is the cost of multiplication.
+void DivideAndConquer(uint64_t *q, uint64_t *u, size_t un, uint64_t const *v,
+                      size_t vn, size_t threshold) {
+  std::vector<uint64_t> scratch(vn);
+  size_t qn    = un - vn;
+  size_t block = qn % vn == 0 ? vn : qn % vn;
+  for (size_t j = qn - block;; j -= vn) {
+    [[maybe_unused]] uint64_t q_high =
+        DivideBlock(q + j, u + j, v, vn, block, threshold, scratch.data());
+    assert(q_high == 0);
+    if (j == 0) { break; }
+    block = vn;
+  }
+}
+
+// Returns the quotient and remainder of `(high * 2^64 + low) / d.normalized`
+// by Algorithm 4 of Möller and Granlund. Requires `high < d.normalized`.
+std::pair<uint64_t, uint64_t> DivideLimbs(uint64_t high, uint64_t low,
+                                          LimbDivisor const &d) {
+  assert(high < d.normalized);
+  auto [q0, q1] = MultiplyLimbs(d.reciprocal, high);
+  uint64_t carry = 0;
+  q0             = AddWithCarry(q0, low, carry);
+  q1 += high + 1 + carry;
+  uint64_t r = low - q1 * d.normalized;
+  // The first correction is taken about half the time, so it is applied with a
+  // mask rather than a branch. The second is rare.
+  uint64_t mask = 0 - static_cast<uint64_t>(r > q0);
+  q1 += mask;
+  r += mask & d.normalized;
+  if (r >= d.normalized) [[unlikely]] {
+    ++q1;
+    r -= d.normalized;
+  }
+  return {q1, r};
+}
+
+// Returns limb `i` of `a[0, n) << shift`, where `0 < shift < 64`.
+uint64_t ShiftedLimb(uint64_t const *a, size_t i, int shift) {
+  uint64_t limb = a[i] << shift;
+  if (i > 0) { limb |= a[i - 1] >> (64 - shift); }
+  return limb;
+}
+
+// Returns the inverse of the odd `d` modulo `2^64`. Every odd `d` is its own
+// inverse modulo 8, and each Newton step doubles the number of correct bits.
+uint64_t InverseLimb(uint64_t d) {
+  assert(d % 2 == 1);
+  uint64_t inverse = d;
+  for (int i = 0; i < 5; ++i) { inverse *= 2 - d * inverse; }
+  return inverse;
+}
+
+// Sets `r[0, n)` to the low `n` limbs of `a[0, an) >> shift`. Requires
+// `n <= an` and `0 <= shift < 64`.
+void ShiftRightInto(uint64_t *r, uint64_t const *a, size_t an, size_t n,
+                    int shift) {
+  if (shift == 0) {
+    std::copy(a, a + n, r);
+    return;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    r[i] = a[i] >> shift;
+    if (i + 1 < an) { r[i] |= a[i + 1] << (64 - shift); }
+  }
+}
+
+}  // namespace
+
+LimbDivisor::LimbDivisor(uint64_t d)
+    : normalized(d << std::countl_zero(d)), shift(std::countl_zero(d)) {
+  assert(d != 0);
+  reciprocal = absl::Uint128Low64(
+      absl::MakeUint128(~normalized, ~uint64_t{0}) / normalized);
+}
+
+uint64_t DivRemOne(uint64_t *q, uint64_t const *a, size_t n,
+                   LimbDivisor const &d) {
+  if (n == 0) { return 0; }
+  if (d.shift == 0) {
+    uint64_t remainder = 0;
+    for (size_t i = n; i-- > 0;) {
+      std::tie(q[i], remainder) = DivideLimbs(remainder, a[i], d);
+    }
+    return remainder;
+  }
+  // Divide `a << shift` by the normalized divisor, shifting each limb as it is
+  // read. Each limb of `a` is read before the quotient limb at or above it is
+  // written, so `q` may alias `a`.
+  uint64_t remainder = a[n - 1] >> (64 - d.shift);
+  for (size_t i = n; i-- > 0;) {
+    std::tie(q[i], remainder) =
+        DivideLimbs(remainder, ShiftedLimb(a, i, d.shift), d);
+  }
+  return remainder >> d.shift;
+}
+
+uint64_t RemOne(uint64_t const *a, size_t n, LimbDivisor const &d) {
+  if (n == 0) { return 0; }
+  uint64_t remainder = d.shift == 0 ? 0 : a[n - 1] >> (64 - d.shift);
+  for (size_t i = n; i-- > 0;) {
+    uint64_t limb = d.shift == 0 ? a[i] : ShiftedLimb(a, i, d.shift);
+    remainder     = DivideLimbs(remainder, limb, d).second;
+  }
+  return remainder >> d.shift;
+}
+
+uint64_t DivRemOne(uint64_t *q, uint64_t const *a, size_t n, uint64_t d) {
+  if (n == 1) {
+    // Preparing the divisor costs more than the single division it would save.
+    uint64_t remainder = a[0] % d;
+    q[0]               = a[0] / d;
+    return remainder;
+  }
+  return DivRemOne(q, a, n, LimbDivisor(d));
+}
+
+uint64_t RemOne(uint64_t const *a, size_t n, uint64_t d) {
+  if (n == 1) { return a[0] % d; }
+  return RemOne(a, n, LimbDivisor(d));
+}
+
+void DivExactOne(uint64_t *q, uint64_t const *a, size_t n, uint64_t d) {
+  assert(d != 0);
+  int shift        = std::countr_zero(d);
+  d >>= shift;
+  uint64_t inverse = InverseLimb(d);
+  // Each quotient limb is the low limb of what remains of the numerator times
+  // the inverse, and the high limb of its product with `d` is borrowed from
+  // the limbs that remain.
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t limb = a[i] >> shift;
+    if (shift != 0 and i + 1 < n) { limb |= a[i + 1] << (64 - shift); }
+    uint64_t difference = limb - borrow;
+    borrow              = limb < borrow;
+    q[i]                = difference * inverse;
+    borrow += MultiplyLimbs(q[i], d).second;
+  }
+}
+
+void DivRem(uint64_t *q, uint64_t *r, uint64_t const *a, size_t an,
+            uint64_t const *b, size_t bn) {
+  if (bn == 1) {
+    r[0] = DivRemOne(q, a, an, b[0]);
+    return;
+  }
+
+  // Normalize so that the divisor's high bit is set, which guarantees the
+  // quotient estimates in `SchoolbookDivide` are nearly exact.
+  int shift = std::countl_zero(b[bn - 1]);
+  std::vector<uint64_t> v(b, b + bn);
+  std::vector<uint64_t> u(an + 1);
+  if (shift == 0) {
+    std::copy(a, a + an, u.begin());
+  } else {
+    ShiftLeft(v.data(), b, bn, shift);
+    u[an] = ShiftLeft(u.data(), a, an, shift);
+  }
+
+  size_t threshold =
+      std::max<size_t>(GlobalIntegerThresholds().burnikel_ziegler_division, 4);
+  if (bn >= threshold) {
+    DivideAndConquer(q, u.data(), an + 1, v.data(), bn, threshold);
+  } else {
+    [[maybe_unused]] uint64_t q_high =
+        SchoolbookDivide(q, u.data(), an + 1, v.data(), bn);
+    assert(q_high == 0);
+  }
+
+  if (shift == 0) {
+    std::copy(u.begin(), u.begin() + bn, r);
+  } else {
+    ShiftRight(r, u.data(), bn, shift);
+  }
+}
+
+void DivExact(uint64_t *q, uint64_t const *a, size_t an, uint64_t const *b,
+              size_t bn) {
+  if (bn == 1) {
+    DivExactOne(q, a, an, b[0]);
+    return;
+  }
+  size_t qn = an - bn + 1;
+  size_t threshold =
+      std::max<size_t>(GlobalIntegerThresholds().burnikel_ziegler_division, 4);
+  if (std::min(qn, bn) >= threshold) {
+    std::vector<uint64_t> r(bn);
+    DivRem(q, r.data(), a, an, b, bn);
+    return;
+  }
+
+  // Divide out the power of two in `b`, which also divides `a`, leaving an odd
+  // divisor. Only the low `qn` limbs of each operand affect the quotient.
+  size_t zeros = std::find_if(b, b + bn, [](uint64_t n) { return n != 0; }) - b;
+  int shift    = std::countr_zero(b[zeros]);
+  size_t vn    = std::min(bn - zeros, qn);
+  std::vector<uint64_t> u(qn), v(vn);
+  ShiftRightInto(u.data(), a + zeros, an - zeros, qn, shift);
+  ShiftRightInto(v.data(), b + zeros, bn - zeros, vn, shift);
+  vn = Normalized(v.data(), vn);
+
+  uint64_t inverse = InverseLimb(v[0]);
+  for (size_t i = 0; i < qn; ++i) {
+    q[i]            = u[i] * inverse;
+    size_t n        = std::min(vn, qn - i);
+    uint64_t borrow = SubMulOne(u.data() + i, v.data(), n, q[i]);
+    SubOne(u.data() + i + n, u.data() + i + n, qn - i - n, borrow);
+  }
+}
+
+}  // namespace chalk::internal_integer
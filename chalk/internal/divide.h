@@ -0,0 +1,56 @@
+#ifndef CHALK_INTERNAL_DIVIDE_H
+#define CHALK_INTERNAL_DIVIDE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chalk::internal_integer {
+
+// A non-zero single-limb divisor, prepared for repeated division. Following
+// Möller and Granlund, "Improved division by invariant integers", the divisor
+// is normalized so that its high bit is set, and the reciprocal
+// `floor((2^128 - 1) / normalized) - 2^64` is computed once. Each limb of a
+// quotient then costs two multiplications rather than a hardware division.
+struct LimbDivisor {
+  explicit LimbDivisor(uint64_t d);
+
+  uint64_t normalized;
+  int shift;
+  uint64_t reciprocal;
+};
+
+// Sets `q[0, n)` to `a[0, n) / d` and returns the remainder. Requires `d` to be
+// non-zero. `q` may alias `a`.
+uint64_t DivRemOne(uint64_t *q, uint64_t const *a, size_t n, uint64_t d);
+uint64_t DivRemOne(uint64_t *q, uint64_t const *a, size_t n,
+                   LimbDivisor const &d);
+
+// Returns `a[0, n) % d`. Requires `d` to be non-zero.
+uint64_t RemOne(uint64_t const *a, size_t n, uint64_t d);
+uint64_t RemOne(uint64_t const *a, size_t n, LimbDivisor const &d);
+
+// Sets `q[0, n)` to `a[0, n) / d`, where `d` is non-zero and divides `a[0, n)`
+// exactly. The quotient is computed from the least significant limb by
+// multiplying by the inverse of the odd part of `d` modulo `2^64`, without any
+// division. `q` may alias `a`.
+void DivExactOne(uint64_t *q, uint64_t const *a, size_t n, uint64_t d);
+
+// Sets `q[0, an - bn + 1)` to the quotient and `r[0, bn)` to the remainder of
+// `a[0, an) / b[0, bn)`. Requires `an >= bn >= 1`, `b[bn - 1] != 0`, and that
+// neither output overlap an input or the other output.
+void DivRem(uint64_t *q, uint64_t *r, uint64_t const *a, size_t an,
+            uint64_t const *b, size_t bn);
+
+// Sets `q[0, an - bn + 1)` to `a[0, an) / b[0, bn)`, where the division is
+// exact. Requires `an >= bn >= 1`, `b[bn - 1] != 0`, and that `q` not overlap
+// either input. Since the quotient is determined by its residue modulo
+// `2^(64 * (an - bn + 1))`, it is computed by Hensel division from the least
+// significant limb, reading only the low limbs of each operand. Divisors and
+// quotients both long enough for Burnikel-Ziegler division use `DivRem`
+// instead.
+void DivExact(uint64_t *q, uint64_t const *a, size_t an, uint64_t const *b,
+              size_t bn);
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_DIVIDE_H
@@ -0,0 +1,191 @@
+#include "chalk/internal/divide.h"
+
+#include <random>
+#include <vector>
+
+#include "chalk/integer_thresholds.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/multiply.h"
+#include "chalk/internal/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+// Checks that `q * b + r == a` and `r < b`.
+void ExpectValidDivision(std::vector<uint64_t> const &a,
+                         std::vector<uint64_t> const &b) {
+  std::vector<uint64_t> q(a.size() - b.size() + 1), r(b.size());
+  DivRem(q.data(), r.data(), a.data(), a.size(), b.data(), b.size());
+  EXPECT_LT(Compare(r.data(), b.data(), b.size()), 0);
+
+  std::vector<uint64_t> product(q.size() + b.size());
+  Multiply(product.data(), q.data(), q.size(), b.data(), b.size());
+  EXPECT_EQ(Add(product.data(), product.data(), product.size(), r.data(),
+                r.size()),
+            0u);
+  product.resize(a.size());
+  EXPECT_EQ(product, a);
+}
+
+TEST(DivRem, Random) {
+  std::mt19937_64 gen(0);
+  for (size_t bn : {1, 2, 3, 7, 30}) {
+    for (size_t extra : {0, 1, 2, 5, 40}) {
+      for (int trial = 0; trial < 10; ++trial) {
+        auto a = RandomNormalizedLimbs(bn + extra, gen);
+        auto b = RandomNormalizedLimbs(bn, gen);
+        ExpectValidDivision(a, b);
+      }
+    }
+  }
+}
+
+TEST(DivRem, QuotientEstimateCorrections) {
+  // Divisors whose high limb is minimal after normalization, and numerators
+  // that maximize the initial quotient estimate, force the rarely-taken
+  // correction paths.
+  std::vector<uint64_t> b = {~uint64_t{0}, 0, uint64_t{1} << 63};
+  std::vector<uint64_t> a = {0, 0, 0, ~uint64_t{0}, (uint64_t{1} << 63) - 1};
+  ExpectValidDivision(a, b);
+  b = {1, 0, 1};
+  a = {~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}, 0};
+  ExpectValidDivision(a, b);
+  b = {~uint64_t{0}, ~uint64_t{0}};
+  a = {~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0} - 1};
+  ExpectValidDivision(a, b);
+}
+
+struct BurnikelZiegler : testing::Test {
+  void SetUp() override { saved_ = GlobalIntegerThresholds(); }
+  void TearDown() override { GlobalIntegerThresholds() = saved_; }
+
+  std::mt19937_64 gen_{0};
+
+ private:
+  IntegerThresholds saved_;
+};
+
+TEST_F(BurnikelZiegler, Random) {
+  GlobalIntegerThresholds().burnikel_ziegler_division = 4;
+  for (size_t bn : {4, 5, 9, 16, 33, 100}) {
+    for (size_t extra : {0, 1, 3, 16, 99, 100, 250}) {
+      for (int trial = 0; trial < 3; ++trial) {
+        auto a = RandomNormalizedLimbs(bn + extra, gen_);
+        auto b = RandomNormalizedLimbs(bn, gen_);
+        ExpectValidDivision(a, b);
+      }
+    }
+  }
+}
+
+TEST_F(BurnikelZiegler, ExtremeLimbs) {
+  // Divisors consisting of a single high bit followed by zeros, and numerators
+  // of all ones, produce the largest errors in the recursive quotient
+  // estimates.
+  GlobalIntegerThresholds().burnikel_ziegler_division = 6;
+  for (size_t bn : {6, 13, 40}) {
+    std::vector<uint64_t> b(bn, 0);
+    b.back() = uint64_t{1} << 63;
+    std::vector<uint64_t> ones(bn, ~uint64_t{0});
+    for (size_t an : {bn, bn + 1, 2 * bn, 3 * bn + 5}) {
+      ExpectValidDivision(std::vector<uint64_t>(an, ~uint64_t{0}), b);
+      ExpectValidDivision(std::vector<uint64_t>(an, ~uint64_t{0}), ones);
+      b[0] = 1;
+      ExpectValidDivision(std::vector<uint64_t>(an, ~uint64_t{0}), b);
+      b[0] = 0;
+    }
+  }
+}
+
+TEST(DivRemOne, Random) {
+  std::mt19937_64 gen(0);
+  for (size_t n : {1, 2, 10, 33}) {
+    auto a = RandomNormalizedLimbs(n, gen);
+    for (uint64_t d : {uint64_t{1}, uint64_t{3}, uint64_t{10}, uint64_t{1} << 63,
+                       (uint64_t{1} << 63) + 1, ~uint64_t{0}, uint64_t{gen()},
+                       uint64_t{gen() >> 40}}) {
+      std::vector<uint64_t> q(n);
+      uint64_t remainder = DivRemOne(q.data(), a.data(), n, d);
+      EXPECT_LT(remainder, d);
+      EXPECT_EQ(RemOne(a.data(), n, d), remainder);
+      std::vector<uint64_t> product(n);
+      EXPECT_EQ(MulOne(product.data(), q.data(), n, d), 0u);
+      EXPECT_EQ(AddOne(product.data(), product.data(), n, remainder), 0u);
+      EXPECT_EQ(product, a);
+    }
+  }
+}
+
+TEST(DivRemOne, InPlace) {
+  std::mt19937_64 gen(0);
+  for (uint64_t d : {uint64_t{7}, ~uint64_t{0} / 3, uint64_t{1} << 40}) {
+    auto a = RandomNormalizedLimbs(20, gen);
+    std::vector<uint64_t> q(a.size());
+    uint64_t remainder = DivRemOne(q.data(), a.data(), a.size(), d);
+    EXPECT_EQ(DivRemOne(a.data(), a.data(), a.size(), LimbDivisor(d)),
+              remainder);
+    EXPECT_EQ(a, q);
+  }
+}
+
+TEST(DivExactOne, Random) {
+  std::mt19937_64 gen(0);
+  for (size_t n : {1, 2, 10, 33}) {
+    auto q = RandomNormalizedLimbs(n, gen);
+    for (uint64_t d : {uint64_t{1}, uint64_t{3}, uint64_t{12}, uint64_t{1} << 63,
+                       ~uint64_t{0}, uint64_t{gen()}, uint64_t{gen() << 20}}) {
+      if (d == 0) { continue; }
+      std::vector<uint64_t> a(n + 1);
+      a[n] = MulOne(a.data(), q.data(), n, d);
+      std::vector<uint64_t> result(n + 1);
+      DivExactOne(result.data(), a.data(), n + 1, d);
+      EXPECT_EQ(std::vector<uint64_t>(result.begin(), result.begin() + n), q);
+      EXPECT_EQ(result[n], 0u);
+    }
+  }
+}
+
+// Checks that `DivExact` recovers `q` from `q * b`.
+void ExpectExactDivision(std::vector<uint64_t> const &q,
+                         std::vector<uint64_t> const &b) {
+  std::vector<uint64_t> a(q.size() + b.size());
+  Multiply(a.data(), q.data(), q.size(), b.data(), b.size());
+  a.resize(Normalized(a.data(), a.size()));
+  std::vector<uint64_t> result(a.size() - b.size() + 1);
+  DivExact(result.data(), a.data(), a.size(), b.data(), b.size());
+  result.resize(q.size(), 0);
+  EXPECT_EQ(result, q);
+}
+
+TEST(DivExact, Random) {
+  std::mt19937_64 gen(0);
+  for (size_t bn : {1, 2, 3, 7, 30}) {
+    for (size_t qn : {1, 2, 5, 40}) {
+      for (int trial = 0; trial < 10; ++trial) {
+        auto q = RandomNormalizedLimbs(qn, gen);
+        auto b = RandomNormalizedLimbs(bn, gen);
+        ExpectExactDivision(q, b);
+        // Even divisors, including those with whole zero limbs.
+        b[0] &= ~uint64_t{0} << (trial * 6);
+        if (bn > 1 and trial % 2 == 0) { b[0] = 0; }
+        if (b.back() == 0) { b.back() = 2; }
+        ExpectExactDivision(q, b);
+      }
+    }
+  }
+}
+
+TEST_F(BurnikelZiegler, DivExact) {
+  GlobalIntegerThresholds().burnikel_ziegler_division = 4;
+  for (size_t bn : {4, 9, 40}) {
+    for (size_t qn : {1, 4, 9, 100}) {
+      ExpectExactDivision(RandomNormalizedLimbs(qn, gen_),
+                          RandomNormalizedLimbs(bn, gen_));
+    }
+  }
+}
+
+}  // namespace
+}  // namespace chalk::internal_integer
@@ -0,0 +1,511 @@
+#include "chalk/internal/gcd.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "absl/numeric/int128.h"
+#include "chalk/integer_thresholds.h"
+#include "chalk/internal/divide.h"
+#include "chalk/internal/limb_vector.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/multiply.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+constexpr size_t kMinimumHalfGcdSize = 4;
+
+// The number of bits by which the values reduced by a half-gcd of leading bits
+// are kept larger than the entries of its matrix, so that the discarded
+// trailing bits are vanishingly unlikely to change any of its quotients.
+constexpr size_t kMarginBits = 64;
+
+size_t HalfGcdThreshold() {
+  return std::max(GlobalIntegerThresholds().half_gcd, kMinimumHalfGcdSize);
+}
+
+int CountTrailingZeros(absl::uint128 a) {
+  uint64_t low = absl::Uint128Low64(a);
+  return low != 0 ? std::countr_zero(low)
+                  : 64 + std::countr_zero(absl::Uint128High64(a));
+}
+
+absl::uint128 BinaryGcd(absl::uint128 a, absl::uint128 b) {
+  if (a == 0) { return b; }
+  if (b == 0) { return a; }
+  int shift = CountTrailingZeros(a | b);
+  a >>= CountTrailingZeros(a);
+  do {
+    if (absl::Uint128High64(a | b) == 0) {
+      absl::uint128 gcd =
+          GcdOne(absl::Uint128Low64(a), absl::Uint128Low64(b));
+      return gcd << shift;
+    }
+    b >>= CountTrailingZeros(b);
+    if (a > b) { std::swap(a, b); }
+    b -= a;
+  } while (b != 0);
+  return a << shift;
+}
+
+Limbs Product(Limbs const &a, Limbs const &b) {
+  if (a.empty() or b.empty()) { return {}; }
+  Limbs result(a.size() + b.size());
+  Multiply(result.data(), a.data(), a.size(), b.data(), b.size());
+  Normalize(result);
+  return result;
+}
+
+Limbs Sum(Limbs const &a, Limbs const &b) {
+  Limbs const &longer  = a.size() >= b.size() ? a : b;
+  Limbs const &shorter = a.size() >= b.size() ? b : a;
+  Limbs result(longer.size() + 1);
+  result.back() = Add(result.data(), longer.data(), longer.size(),
+                      shorter.data(), shorter.size());
+  Normalize(result);
+  return result;
+}
+
+// Sets `r` to `a - b` and returns true, or returns false if `a < b`.
+bool Difference(Limbs &r, Limbs const &a, Limbs const &b) {
+  if (Compare(a, b) < 0) { return false; }
+  r.resize(a.size());
+  Sub(r.data(), a.data(), a.size(), b.data(), b.size());
+  Normalize(r);
+  return true;
+}
+
+// Returns `a / 2^bits`, rounded down.
+Limbs ShiftedDown(Limbs const &a, size_t bits) {
+  if (bits / 64 >= a.size()) { return {}; }
+  Limbs result(a.begin() + bits / 64, a.end());
+  if (bits % 64 != 0) {
+    ShiftRight(result.data(), result.data(), result.size(), bits % 64);
+  }
+  Normalize(result);
+  return result;
+}
+
+// Returns `a * 2^bits`.
+Limbs ShiftedUp(Limbs const &a, size_t bits) {
+  if (a.empty()) { return {}; }
+  Limbs result(bits / 64 + a.size() + 1);
+  uint64_t *r = result.data() + bits / 64;
+  if (bits % 64 == 0) {
+    std::copy(a.begin(), a.end(), r);
+  } else {
+    r[a.size()] = ShiftLeft(r, a.data(), a.size(), bits % 64);
+  }
+  Normalize(result);
+  return result;
+}
+
+// Returns `a mod 2^bits`.
+Limbs LowBits(Limbs const &a, size_t bits) {
+  size_t n = (bits + 63) / 64;
+  if (a.size() < n) { return a; }
+  Limbs result(a.begin(), a.begin() + n);
+  if (bits % 64 != 0) { result.back() &= (uint64_t{1} << (bits % 64)) - 1; }
+  Normalize(result);
+  return result;
+}
+
+// A run of steps of Euclid's algorithm, each taking `(u, v)` to
+// `(v, u - q * v)`, composes to a matrix `K` of non-negative integers with
+// `(u, v) = K (u', v')`, each step multiplying `K` on the right by
+// `[[q, 1], [1, 0]]`. Its determinant is -1 raised to the number of steps,
+// recorded by `odd`, so that
+//   `(u', v') = (k11 * u - k01 * v, k00 * v - k10 * u)`
+// if `odd` is false, and the negation of that if it is true.
+struct Matrix {
+  static Matrix Identity() { return Matrix{{1}, {}, {}, {1}}; }
+
+  bool IsIdentity() const { return k01.empty() and k10.empty(); }
+
+  Limbs k00, k01, k10, k11;
+  bool odd = false;
+};
+
+// As `Matrix`, with entries of a single limb.
+struct Step {
+  uint64_t k00 = 1, k01 = 0, k10 = 0, k11 = 1;
+  bool odd     = false;
+};
+
+Matrix MatrixProduct(Matrix const &a, Matrix const &b) {
+  return Matrix{
+      .k00 = Sum(Product(a.k00, b.k00), Product(a.k01, b.k10)),
+      .k01 = Sum(Product(a.k00, b.k01), Product(a.k01, b.k11)),
+      .k10 = Sum(Product(a.k10, b.k00), Product(a.k11, b.k10)),
+      .k11 = Sum(Product(a.k10, b.k01), Product(a.k11, b.k11)),
+      .odd = a.odd != b.odd,
+  };
+}
+
+// Sets `k` to `k * step`.
+void MultiplyOnRight(Matrix &k, Step const &step) {
+  auto row = [&](Limbs &left, Limbs &right) {
+    size_t n = std::max(left.size(), right.size());
+    left.resize(n);
+    right.resize(n);
+    Limbs new_left(n + 2), new_right(n + 2);
+    new_left[n]  = MulOne(new_left.data(), left.data(), n, step.k00);
+    new_right[n] = MulOne(new_right.data(), left.data(), n, step.k01);
+    AddOne(new_left.data() + n, new_left.data() + n, 2,
+           AddMulOne(new_left.data(), right.data(), n, step.k10));
+    AddOne(new_right.data() + n, new_right.data() + n, 2,
+           AddMulOne(new_right.data(), right.data(), n, step.k11));
+    Normalize(new_left);
+    Normalize(new_right);
+    left  = std::move(new_left);
+    right = std::move(new_right);
+  };
+  row(k.k00, k.k01);
+  row(k.k10, k.k11);
+  k.odd = k.odd != step.odd;
+}
+
+// Sets `k` to `k * [[q, 1], [1, 0]]`.
+void MultiplyOnRight(Matrix &k, Limbs const &q) {
+  Limbs k00 = Sum(Product(k.k00, q), k.k01);
+  Limbs k10 = Sum(Product(k.k10, q), k.k11);
+  k.k01     = std::move(k.k00);
+  k.k00     = std::move(k00);
+  k.k11     = std::move(k.k10);
+  k.k10     = std::move(k10);
+  k.odd     = not k.odd;
+}
+
+// Sets `(u, v)` to `k^-1 (u, v)`, given `(high_u, high_v) = k^-1 (u, v) / 2^p`
+// computed from the bits above `p` alone. By linearity, only the low `p` bits
+// remain to be multiplied by the entries of `k`, which are much shorter than
+// `u`. Returns true if the result is a pair `u >= v >= 0`, as it is whenever
+// the steps of `k` are the first steps of Euclid's algorithm on `(u, v)`.
+// Otherwise returns false, leaving `(u, v)` unchanged.
+bool ApplyInverse(Matrix const &k, Limbs const &high_u, Limbs const &high_v,
+                  size_t p, Limbs &u, Limbs &v) {
+  Limbs low_u = LowBits(u, p);
+  Limbs low_v = LowBits(v, p);
+  Limbs k11_u = Product(k.k11, low_u);
+  Limbs k01_v = Product(k.k01, low_v);
+  Limbs k00_v = Product(k.k00, low_v);
+  Limbs k10_u = Product(k.k10, low_u);
+  if (k.odd) {
+    // The signs of both combinations are reversed.
+    std::swap(k11_u, k01_v);
+    std::swap(k00_v, k10_u);
+  }
+  Limbs u_plus = Sum(ShiftedUp(high_u, p), k11_u);
+  Limbs v_plus = Sum(ShiftedUp(high_v, p), k00_v);
+  Limbs new_u, new_v;
+  if (not Difference(new_u, u_plus, k01_v) or
+      not Difference(new_v, v_plus, k10_u) or
+      Compare(new_u.data(), new_u.size(), new_v.data(), new_v.size()) < 0) {
+    return false;
+  }
+  u = std::move(new_u);
+  v = std::move(new_v);
+  return true;
+}
+
+// Sets `out` to `x * kx - y * ky`, which must be non-negative, where `x` and
+// `y` each have `n` limbs.
+void Combine(Limbs &out, Limbs const &x, uint64_t kx, Limbs const &y,
+             uint64_t ky, size_t n) {
+  out.resize(n + 1);
+  out[n] = MulOne(out.data(), x.data(), n, kx);
+  out[n] -= SubMulOne(out.data(), y.data(), n, ky);
+  assert(out[n] == 0);
+  Normalize(out);
+}
+
+// Sets `(u, v)` to `step^-1 (u, v)`, where the steps of `step` are known to be
+// the first steps of Euclid's algorithm on `(u, v)`. The scratch vectors are
+// swapped with `u` and `v` to avoid allocating on every step.
+void ApplyInverse(Step const &step, Limbs &u, Limbs &v, Limbs &scratch_u,
+                  Limbs &scratch_v) {
+  size_t n = u.size();
+  v.resize(n);
+  if (step.odd) {
+    Combine(scratch_u, v, step.k01, u, step.k11, n);
+    Combine(scratch_v, u, step.k10, v, step.k00, n);
+  } else {
+    Combine(scratch_u, u, step.k11, v, step.k01, n);
+    Combine(scratch_v, v, step.k00, u, step.k10, n);
+  }
+  std::swap(u, scratch_u);
+  std::swap(v, scratch_v);
+}
+
+// Returns the 128 bits of `a[0, n)` starting at bit `shift`.
+absl::uint128 Window(uint64_t const *a, size_t n, size_t shift) {
+  auto limb       = [&](size_t i) { return i < n ? a[i] : uint64_t{0}; };
+  size_t index    = shift / 64;
+  int offset      = shift % 64;
+  uint64_t low    = limb(index);
+  uint64_t middle = limb(index + 1);
+  if (offset == 0) { return absl::MakeUint128(middle, low); }
+  uint64_t high = limb(index + 2);
+  return absl::MakeUint128((middle >> offset) | (high << (64 - offset)),
+                           (low >> offset) | (middle << (64 - offset)));
+}
+
+// Sets `product` to `q * y` and returns true, or returns false if the product
+// does not fit in 128 bits.
+bool MultiplyWithoutOverflow(uint64_t q, absl::uint128 y,
+                             absl::uint128 &product) {
+  absl::uint128 low  = absl::uint128(q) * absl::Uint128Low64(y);
+  absl::uint128 high = absl::uint128(q) * absl::Uint128High64(y);
+  if (absl::Uint128High64(high) != 0) { return false; }
+  absl::uint128 shifted = absl::MakeUint128(absl::Uint128Low64(high), 0);
+  product               = low + shifted;
+  return product >= shifted;
+}
+
+// Sets `step` to as many of the first steps of Euclid's algorithm on `u >= v`
+// as can be determined from their leading 127 bits, and returns whether there
+// was at least one. With `a` and `b` the values of those bits, `u / v` lies
+// strictly between `a / (b + 1)` and `(a + 1) / b`, and a quotient is accepted
+// only if Euclid's algorithm run on both bounds agrees on it (Knuth, TAOCP Vol.
+// 2, 4.5.2, Algorithm L). Each step removes about one and a half bits, so that
+// `step` typically amounts to some 40 steps and has entries of 63 bits. If
+// `minimum_bits` is positive, steps stop before they would leave `v` with no
+// more than about `minimum_bits` bits.
+bool LehmerStep(Limbs const &u, Limbs const &v, size_t minimum_bits,
+                Step &step) {
+  size_t bits  = BitLength(u);
+  size_t shift = bits > 127 ? bits - 127 : 0;
+  absl::uint128 floor = 0;
+  if (minimum_bits > 0) {
+    if (minimum_bits >= shift + 127) { return false; }
+    floor = minimum_bits > shift ? absl::uint128(1) << (minimum_bits - shift)
+                                 : 1;
+  }
+
+  // The two bounds coincide when no bits are discarded.
+  absl::uint128 a  = Window(u.data(), u.size(), shift);
+  absl::uint128 b  = Window(v.data(), v.size(), shift);
+  absl::uint128 x1 = a + (shift > 0);
+  absl::uint128 y1 = b;
+  absl::uint128 x2 = a;
+  absl::uint128 y2 = b + (shift > 0);
+
+  step          = Step{};
+  bool progress = false;
+  while (y1 != 0 and y2 != 0) {
+    absl::uint128 q;
+    absl::uint128 r1 = x1 - y1;
+    if (r1 < y1) {
+      q = 1;
+    } else {
+      q  = x1 / y1;
+      r1 = x1 - q * y1;
+    }
+    if (absl::Uint128High64(q) != 0) { break; }
+    uint64_t quotient = absl::Uint128Low64(q);
+
+    absl::uint128 product;
+    if (not MultiplyWithoutOverflow(quotient, y2, product) or product > x2) {
+      break;
+    }
+    absl::uint128 r2 = x2 - product;
+    if (r2 >= y2 or r1 < floor or r2 < floor) { break; }
+
+    absl::uint128 k00 = absl::uint128(quotient) * step.k00 + step.k01;
+    absl::uint128 k10 = absl::uint128(quotient) * step.k10 + step.k11;
+    if (absl::Uint128High64(k00) != 0 or absl::Uint128High64(k10) != 0) {
+      break;
+    }
+    step = Step{
+        .k00 = absl::Uint128Low64(k00),
+        .k01 = step.k00,
+        .k10 = absl::Uint128Low64(k10),
+        .k11 = step.k10,
+        .odd = not step.odd,
+    };
+    x1       = y1;
+    y1       = r1;
+    x2       = y2;
+    y2       = r2;
+    progress = true;
+  }
+  return progress;
+}
+
+// Replaces `(u, v)` with `(v, u mod v)`, accumulating the step into `k` if it
+// is non-null, and returns true. If `minimum_bits` is positive and the
+// remainder has no more than `minimum_bits` bits, instead returns false,
+// leaving `(u, v)` unchanged.
+bool DivisionStep(Limbs &u, Limbs &v, size_t minimum_bits, Matrix *k) {
+  Limbs q(u.size() - v.size() + 1), r(v.size());
+  DivRem(q.data(), r.data(), u.data(), u.size(), v.data(), v.size());
+  Normalize(r);
+  if (minimum_bits > 0 and BitLength(r) <= minimum_bits) { return false; }
+  if (k != nullptr) {
+    Normalize(q);
+    MultiplyOnRight(*k, q);
+  }
+  u = std::move(v);
+  v = std::move(r);
+  return true;
+}
+
+// Performs steps of Euclid's algorithm on `u >= v`, accumulating them into `k`
+// if it is non-null, until `v` is zero or, if `minimum_bits` is positive, until
+// a further step would leave `v` with no more than about `minimum_bits` bits.
+void EuclidSteps(Limbs &u, Limbs &v, size_t minimum_bits, Matrix *k) {
+  Limbs scratch_u, scratch_v;
+  while (BitLength(v) > minimum_bits) {
+    if (k == nullptr and minimum_bits == 0 and u.size() <= 2) {
+      absl::uint128 gcd = BinaryGcd(Window(u.data(), u.size(), 0),
+                                    Window(v.data(), v.size(), 0));
+      u = {absl::Uint128Low64(gcd), absl::Uint128High64(gcd)};
+      Normalize(u);
+      v.clear();
+      return;
+    }
+
+    Step step;
+    if (LehmerStep(u, v, minimum_bits, step)) {
+      ApplyInverse(step, u, v, scratch_u, scratch_v);
+      if (k != nullptr) { MultiplyOnRight(*k, step); }
+    } else if (not DivisionStep(u, v, minimum_bits, k)) {
+      return;
+    }
+  }
+}
+
+Matrix HalfGcd(Limbs &u, Limbs &v, size_t minimum_bits);
+
+// Computes a half-gcd of the bits of `u` and `v` above bit `p`, aiming to leave
+// `v` with just over `target` bits, and applies it to `(u, v)`, accumulating it
+// into `k`. Since the half-gcd keeps its reduced values `kMarginBits` larger
+// than the entries of its matrix, the discarded bits almost never alter its
+// steps. On the rare occasion that they do, the matrix is discarded, leaving
+// the reduction to the caller.
+void ReduceLeadingBits(Limbs &u, Limbs &v, size_t p, size_t target,
+                       Matrix &k) {
+  Limbs leading_u  = ShiftedDown(u, p);
+  Limbs leading_v  = ShiftedDown(v, p);
+  Matrix reduction = HalfGcd(leading_u, leading_v, target - p);
+  if (reduction.IsIdentity() or
+      not ApplyInverse(reduction, leading_u, leading_v, p, u, v)) {
+    return;
+  }
+  k = MatrixProduct(k, reduction);
+}
+
+// Performs steps of Euclid's algorithm on `u >= v` until a further step would
+// leave `v` with no more than about `minimum_bits` bits, and returns the matrix
+// of the steps. Long operands remove the first half of the bits to be removed
+// with a recursive half-gcd of the leading bits, and then the second half with
+// another, so that the work is dominated by the multiplications applying the
+// resulting matrices.
+Matrix HalfGcd(Limbs &u, Limbs &v, size_t minimum_bits) {
+  Matrix k = Matrix::Identity();
+  if (u.size() >= HalfGcdThreshold()) {
+    size_t bits = BitLength(u);
+    if (bits > minimum_bits) {
+      size_t half    = (bits - minimum_bits) / 2;
+      size_t leading = 2 * half + 2 * kMarginBits;
+      if (leading < bits) {
+        ReduceLeadingBits(u, v, bits - leading, bits - half, k);
+      }
+    }
+
+    bits = BitLength(u);
+    if (bits > minimum_bits) {
+      size_t leading = 2 * (bits - minimum_bits) + 2 * kMarginBits;
+      if (leading < bits) {
+        ReduceLeadingBits(u, v, bits - leading, minimum_bits, k);
+      }
+    }
+  }
+  EuclidSteps(u, v, minimum_bits, &k);
+  return k;
+}
+
+// Runs Euclid's algorithm on `u >= v` until `v` is zero, leaving the greatest
+// common divisor in `u` and accumulating the steps into `k` if it is non-null.
+void Reduce(Limbs &u, Limbs &v, Matrix *k) {
+  while (not v.empty()) {
+    if (u.size() < HalfGcdThreshold()) {
+      EuclidSteps(u, v, 0, k);
+      return;
+    }
+    size_t half = BitLength(u) / 2;
+    if (BitLength(v) > half) {
+      Matrix reduction = HalfGcd(u, v, half);
+      if (not reduction.IsIdentity()) {
+        if (k != nullptr) { *k = MatrixProduct(*k, reduction); }
+        continue;
+      }
+    }
+    DivisionStep(u, v, 0, k);
+  }
+}
+
+}  // namespace
+
+uint64_t GcdOne(uint64_t a, uint64_t b) {
+  if (a == 0) { return b; }
+  if (b == 0) { return a; }
+  int shift = std::countr_zero(a | b);
+  a >>= std::countr_zero(a);
+  do {
+    b >>= std::countr_zero(b);
+    if (a > b) { std::swap(a, b); }
+    b -= a;
+  } while (b != 0);
+  return a << shift;
+}
+
+size_t Gcd(uint64_t *r, uint64_t const *a, size_t an, uint64_t const *b,
+           size_t bn) {
+  an = Normalized(a, an);
+  bn = Normalized(b, bn);
+  assert(an > 0 and bn > 0);
+  if (an == 1 and bn == 1) {
+    r[0] = GcdOne(a[0], b[0]);
+    return 1;
+  }
+
+  Limbs u(a, a + an), v(b, b + bn);
+  if (Compare(a, an, b, bn) < 0) { std::swap(u, v); }
+  Reduce(u, v, nullptr);
+  std::copy(u.begin(), u.end(), r);
+  return u.size();
+}
+
+size_t ExtendedGcd(uint64_t *r, uint64_t *x, uint64_t *y, bool &negated,
+                   uint64_t const *a, size_t an, uint64_t const *b,
+                   size_t bn) {
+  size_t x_size = bn;
+  size_t y_size = an;
+  an            = Normalized(a, an);
+  bn            = Normalized(b, bn);
+  assert(an > 0 and bn > 0);
+
+  // Ordering the operands is a step with quotient zero.
+  Limbs u(a, a + an), v(b, b + bn);
+  Matrix k = Matrix::Identity();
+  if (Compare(a, an, b, bn) < 0) {
+    std::swap(u, v);
+    MultiplyOnRight(k, Limbs{});
+  }
+  Reduce(u, v, &k);
+
+  // With `v` zero, `(a, b) = k (g, 0)`, and the coefficients are read off from
+  // the first row of `k^-1`.
+  assert(k.k11.size() <= x_size and k.k01.size() <= y_size);
+  std::fill(std::copy(k.k11.begin(), k.k11.end(), x), x + x_size, 0);
+  std::fill(std::copy(k.k01.begin(), k.k01.end(), y), y + y_size, 0);
+  negated = k.odd;
+  std::copy(u.begin(), u.end(), r);
+  return u.size();
+}
+
+}  // namespace chalk::internal_integer
@@ -0,0 +1,36 @@
+#ifndef CHALK_INTERNAL_GCD_H
+#define CHALK_INTERNAL_GCD_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chalk::internal_integer {
+
+// Returns the greatest common divisor of `a` and `b`, computed with the binary
+// algorithm. The greatest common divisor of zero and zero is zero.
+uint64_t GcdOne(uint64_t a, uint64_t b);
+
+// Sets `r` to the greatest common divisor of `a[0, an)` and `b[0, bn)` and
+// returns its length in limbs. Requires `an` and `bn` to be positive, both
+// values to be non-zero, and `r` to have room for `min(an, bn)` limbs.
+//
+// Values of up to two limbs use the binary algorithm. Longer values are reduced
+// by Lehmer's algorithm, which takes the quotients of many steps of Euclid's
+// algorithm from the leading 127 bits of the operands before applying them all
+// at once, and values of at least `GlobalIntegerThresholds().half_gcd` limbs
+// are first reduced recursively by a half-gcd in time proportional to that of
+// multiplication, up to a logarithmic factor.
+size_t Gcd(uint64_t *r, uint64_t const *a, size_t an, uint64_t const *b,
+           size_t bn);
+
+// As `Gcd`, additionally setting `x[0, bn)` and `y[0, an)` to coefficients
+// with `a * x - b * y` equal to the greatest common divisor if the returned
+// `negated` flag is false, and to its negation if it is true. The coefficients
+// satisfy `x <= b / g` and `y <= a / g`, where `g` is the greatest common
+// divisor.
+size_t ExtendedGcd(uint64_t *r, uint64_t *x, uint64_t *y, bool &negated,
+                   uint64_t const *a, size_t an, uint64_t const *b, size_t bn);
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_GCD_H
@@ -0,0 +1,203 @@
+#include "chalk/internal/gcd.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "chalk/integer_thresholds.h"
+#include "chalk/internal/divide.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/multiply.h"
+#include "chalk/internal/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+using Limbs = std::vector<uint64_t>;
+
+void Normalize(Limbs &a) { a.resize(Normalized(a.data(), a.size())); }
+
+Limbs Product(Limbs const &a, Limbs const &b) {
+  if (a.empty() or b.empty()) { return {}; }
+  Limbs result(a.size() + b.size());
+  Multiply(result.data(), a.data(), a.size(), b.data(), b.size());
+  Normalize(result);
+  return result;
+}
+
+Limbs Sum(Limbs a, Limbs b) {
+  if (a.size() < b.size()) { std::swap(a, b); }
+  a.push_back(0);
+  Add(a.data(), a.data(), a.size(), b.data(), b.size());
+  Normalize(a);
+  return a;
+}
+
+bool Divides(Limbs const &d, Limbs const &a) {
+  if (Compare(a.data(), a.size(), d.data(), d.size()) < 0) { return false; }
+  Limbs q(a.size() - d.size() + 1), r(d.size());
+  DivRem(q.data(), r.data(), a.data(), a.size(), d.data(), d.size());
+  return Normalized(r.data(), r.size()) == 0;
+}
+
+// Checks that `Gcd` and `ExtendedGcd` agree on a common divisor `g` of `a` and
+// `b`, and that the coefficients satisfy `a * x - b * y == ±g` within their
+// documented bounds, which together show that `g` is the greatest.
+void ExpectValidGcd(Limbs const &a, Limbs const &b) {
+  Limbs g(std::min(a.size(), b.size()));
+  g.resize(Gcd(g.data(), a.data(), a.size(), b.data(), b.size()));
+  ASSERT_FALSE(g.empty());
+  EXPECT_NE(g.back(), 0u);
+  EXPECT_TRUE(Divides(g, a));
+  EXPECT_TRUE(Divides(g, b));
+
+  Limbs extended_g(std::min(a.size(), b.size()));
+  Limbs x(b.size()), y(a.size());
+  bool negated;
+  extended_g.resize(ExtendedGcd(extended_g.data(), x.data(), y.data(), negated,
+                                a.data(), a.size(), b.data(), b.size()));
+  EXPECT_EQ(extended_g, g);
+  Normalize(x);
+  Normalize(y);
+
+  Limbs ax = Product(a, x);
+  Limbs by = Product(b, y);
+  if (negated) {
+    EXPECT_EQ(by, Sum(ax, g));
+  } else {
+    EXPECT_EQ(ax, Sum(by, g));
+  }
+  Limbs xg = Product(x, g);
+  Limbs yg = Product(y, g);
+  EXPECT_LE(Compare(xg.data(), xg.size(), b.data(), b.size()), 0);
+  EXPECT_LE(Compare(yg.data(), yg.size(), a.data(), a.size()), 0);
+}
+
+// Returns a pair of values sharing the random factor `g`, so that the greatest
+// common divisor is usually long.
+std::pair<Limbs, Limbs> WithCommonFactor(size_t an, size_t bn, size_t gn,
+                                         std::mt19937_64 &gen) {
+  Limbs g = RandomNormalizedLimbs(gn, gen);
+  return {Product(RandomNormalizedLimbs(an, gen), g),
+          Product(RandomNormalizedLimbs(bn, gen), g)};
+}
+
+// Returns consecutive Fibonacci numbers of at least `n` limbs, for which every
+// quotient in Euclid's algorithm is one.
+std::pair<Limbs, Limbs> Fibonacci(size_t n) {
+  Limbs a = {1}, b = {1};
+  while (a.size() < n) {
+    Limbs next = Sum(a, b);
+    b          = std::move(a);
+    a          = std::move(next);
+  }
+  return {a, b};
+}
+
+TEST(GcdOne, MatchesStandardLibrary) {
+  std::mt19937_64 gen(0);
+  EXPECT_EQ(GcdOne(0, 0), 0u);
+  EXPECT_EQ(GcdOne(0, 12), 12u);
+  EXPECT_EQ(GcdOne(12, 0), 12u);
+  EXPECT_EQ(GcdOne(~uint64_t{0}, ~uint64_t{0}), ~uint64_t{0});
+  for (int trial = 0; trial < 1000; ++trial) {
+    uint64_t a = gen() >> (gen() % 64);
+    uint64_t b = gen() >> (gen() % 64);
+    uint64_t c = gen() >> (48 + gen() % 16);
+    EXPECT_EQ(GcdOne(a, b), std::gcd(a, b));
+    EXPECT_EQ(GcdOne(a * c, b * c), std::gcd(a * c, b * c));
+  }
+}
+
+struct GcdTest : testing::Test {
+  void SetUp() override { saved_ = GlobalIntegerThresholds(); }
+  void TearDown() override { GlobalIntegerThresholds() = saved_; }
+
+  std::mt19937_64 gen_{0};
+
+ private:
+  IntegerThresholds saved_;
+};
+
+TEST_F(GcdTest, Small) {
+  ExpectValidGcd({12}, {18});
+  ExpectValidGcd({18}, {12});
+  ExpectValidGcd({7}, {7});
+  ExpectValidGcd({1}, {~uint64_t{0}});
+  ExpectValidGcd({0, 1}, {2});
+  ExpectValidGcd({0, 1}, {0, 1});
+  ExpectValidGcd({6, 0, 0}, {4, 0});
+}
+
+TEST_F(GcdTest, Random) {
+  for (size_t an : {1, 2, 3, 5, 12, 40}) {
+    for (size_t bn : {1, 2, 3, 5, 12, 40}) {
+      for (int trial = 0; trial < 5; ++trial) {
+        ExpectValidGcd(RandomNormalizedLimbs(an, gen_),
+                       RandomNormalizedLimbs(bn, gen_));
+        auto [a, b] = WithCommonFactor(an, bn, 1 + trial, gen_);
+        ExpectValidGcd(a, b);
+      }
+    }
+  }
+}
+
+TEST_F(GcdTest, Fibonacci) {
+  for (size_t n : {2, 3, 10, 50}) {
+    auto [a, b] = Fibonacci(n);
+    ExpectValidGcd(a, b);
+    ExpectValidGcd(b, a);
+  }
+}
+
+TEST_F(GcdTest, PowersOfTwo) {
+  for (size_t an : {1, 3, 20}) {
+    for (size_t bn : {1, 4, 20}) {
+      Limbs a(an, 0), b(bn, 0);
+      a.back() = uint64_t{1} << 63;
+      b.back() = 1;
+      ExpectValidGcd(a, b);
+      b[0] = 3;
+      ExpectValidGcd(a, b);
+    }
+  }
+}
+
+TEST_F(GcdTest, HalfGcd) {
+  GlobalIntegerThresholds().half_gcd = 4;
+  for (size_t an : {4, 5, 9, 16, 33, 100}) {
+    for (size_t bn : {size_t{1}, size_t{4}, size_t{9}, an - 1, an}) {
+      for (int trial = 0; trial < 3; ++trial) {
+        ExpectValidGcd(RandomNormalizedLimbs(an, gen_),
+                       RandomNormalizedLimbs(bn, gen_));
+        auto [a, b] = WithCommonFactor(an, bn, an / 2, gen_);
+        ExpectValidGcd(a, b);
+      }
+    }
+  }
+  for (size_t n : {4, 17, 60}) {
+    auto [a, b] = Fibonacci(n);
+    ExpectValidGcd(a, b);
+  }
+}
+
+TEST_F(GcdTest, HalfGcdExtremeLimbs) {
+  GlobalIntegerThresholds().half_gcd = 4;
+  for (size_t n : {4, 9, 30}) {
+    Limbs ones(n, ~uint64_t{0});
+    Limbs power(n, 0);
+    power.back() = uint64_t{1} << 63;
+    ExpectValidGcd(ones, power);
+    Limbs almost_ones = ones;
+    almost_ones[0]    = ~uint64_t{0} - 1;
+    ExpectValidGcd(ones, almost_ones);
+    Limbs shorter(ones.begin(), ones.end() - 1);
+    ExpectValidGcd(ones, shorter);
+  }
+}
+
+}  // namespace
+}  // namespace chalk::internal_integer
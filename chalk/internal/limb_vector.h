@@ -0,0 +1,30 @@
+#ifndef CHALK_INTERNAL_LIMB_VECTOR_H
+#define CHALK_INTERNAL_LIMB_VECTOR_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "chalk/internal/limbs.h"
+
+namespace chalk::internal_integer {
+
+// Non-negative values without leading zero limbs, so that zero is empty. Used
+// by algorithms whose intermediate values vary in length too much to be held
+// in preallocated buffers.
+using Limbs = std::vector<uint64_t>;
+
+inline void Normalize(Limbs &a) { a.resize(Normalized(a.data(), a.size())); }
+
+inline int Compare(Limbs const &a, Limbs const &b) {
+  return Compare(a.data(), a.size(), b.data(), b.size());
+}
+
+inline size_t BitLength(Limbs const &a) {
+  return a.empty() ? 0 : 64 * (a.size() - 1) + std::bit_width(a.back());
+}
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_LIMB_VECTOR_H
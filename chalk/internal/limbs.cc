@@ -0,0 +1,187 @@
+#include "chalk/internal/limbs.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+LimbKernels const kPortableKernels = {
+    .mul_one     = PortableMulOne,
+    .add_mul_one = PortableAddMulOne,
+    .sub_mul_one = PortableSubMulOne,
+};
+
+#if defined(__x86_64__) and (defined(__GNUC__) or defined(__clang__))
+
+// Each kernel handles any limbs beyond a multiple of four with the portable
+// loop, and the remaining blocks of four with an unrolled loop in which `mulx`
+// leaves the flags untouched. The high limb of each product is accumulated into
+// the next low limb through the overflow flag (`adox`), while the sum with `r`
+// is carried through the carry flag (`adcx`), so that neither chain waits on
+// the other. The loop counter lives in `rcx` and is tested with `jrcxz`, as
+// every other means of counting would clobber one of the two flags.
+
+uint64_t AdxMulOne(uint64_t *r, uint64_t const *a, size_t n, uint64_t b) {
+  size_t head    = n % 4;
+  uint64_t carry = PortableMulOne(r, a, head, b);
+  size_t blocks  = n / 4;
+  if (blocks == 0) { return carry; }
+  r += head;
+  a += head;
+  uint64_t low, high;
+  __asm__(
+      "xorl %k[low], %k[low]\n\t"
+      "1:\n\t"
+      "mulx (%[a]), %[low], %[high]\n\t"
+      "adcx %[carry], %[low]\n\t"
+      "movq %[low], (%[r])\n\t"
+      "mulx 8(%[a]), %[low], %[carry]\n\t"
+      "adcx %[high], %[low]\n\t"
+      "movq %[low], 8(%[r])\n\t"
+      "mulx 16(%[a]), %[low], %[high]\n\t"
+      "adcx %[carry], %[low]\n\t"
+      "movq %[low], 16(%[r])\n\t"
+      "mulx 24(%[a]), %[low], %[carry]\n\t"
+      "adcx %[high], %[low]\n\t"
+      "movq %[low], 24(%[r])\n\t"
+      "leaq 32(%[a]), %[a]\n\t"
+      "leaq 32(%[r]), %[r]\n\t"
+      "leaq -1(%[blocks]), %[blocks]\n\t"
+      "jrcxz 2f\n\t"
+      "jmp 1b\n"
+      "2:\n\t"
+      "movl $0, %k[low]\n\t"
+      "adcx %[low], %[carry]\n\t"
+      : [carry] "+&r"(carry), [low] "=&r"(low), [high] "=&r"(high),
+        [a] "+&r"(a), [r] "+&r"(r), [blocks] "+&c"(blocks)
+      : "d"(b)
+      : "cc", "memory");
+  return carry;
+}
+
+uint64_t AdxAddMulOne(uint64_t *r, uint64_t const *a, size_t n, uint64_t b) {
+  size_t head    = n % 4;
+  uint64_t carry = PortableAddMulOne(r, a, head, b);
+  size_t blocks  = n / 4;
+  if (blocks == 0) { return carry; }
+  r += head;
+  a += head;
+  uint64_t low, high;
+  __asm__(
+      "xorl %k[low], %k[low]\n\t"
+      "1:\n\t"
+      "mulx (%[a]), %[low], %[high]\n\t"
+      "adox %[carry], %[low]\n\t"
+      "adcx (%[r]), %[low]\n\t"
+      "movq %[low], (%[r])\n\t"
+      "mulx 8(%[a]), %[low], %[carry]\n\t"
+      "adox %[high], %[low]\n\t"
+      "adcx 8(%[r]), %[low]\n\t"
+      "movq %[low], 8(%[r])\n\t"
+      "mulx 16(%[a]), %[low], %[high]\n\t"
+      "adox %[carry], %[low]\n\t"
+      "adcx 16(%[r]), %[low]\n\t"
+      "movq %[low], 16(%[r])\n\t"
+      "mulx 24(%[a]), %[low], %[carry]\n\t"
+      "adox %[high], %[low]\n\t"
+      "adcx 24(%[r]), %[low]\n\t"
+      "movq %[low], 24(%[r])\n\t"
+      "leaq 32(%[a]), %[a]\n\t"
+      "leaq 32(%[r]), %[r]\n\t"
+      "leaq -1(%[blocks]), %[blocks]\n\t"
+      "jrcxz 2f\n\t"
+      "jmp 1b\n"
+      "2:\n\t"
+      "movl $0, %k[low]\n\t"
+      "adox %[low], %[carry]\n\t"
+      "adcx %[low], %[carry]\n\t"
+      : [carry] "+&r"(carry), [low] "=&r"(low), [high] "=&r"(high),
+        [a] "+&r"(a), [r] "+&r"(r), [blocks] "+&c"(blocks)
+      : "d"(b)
+      : "cc", "memory");
+  return carry;
+}
+
+// Subtraction has no counterpart to `adcx` that leaves the overflow flag alone,
+// so `r - low - borrow` is instead computed as `r + ~low + (1 - borrow)`, with
+// the carry flag holding the complement of the borrow.
+uint64_t AdxSubMulOne(uint64_t *r, uint64_t const *a, size_t n, uint64_t b) {
+  size_t head     = n % 4;
+  uint64_t borrow = PortableSubMulOne(r, a, head, b);
+  size_t blocks   = n / 4;
+  if (blocks == 0) { return borrow; }
+  r += head;
+  a += head;
+  uint64_t low, high;
+  __asm__(
+      "xorl %k[low], %k[low]\n\t"
+      "stc\n"
+      "1:\n\t"
+      "mulx (%[a]), %[low], %[high]\n\t"
+      "adox %[borrow], %[low]\n\t"
+      "notq %[low]\n\t"
+      "adcx (%[r]), %[low]\n\t"
+      "movq %[low], (%[r])\n\t"
+      "mulx 8(%[a]), %[low], %[borrow]\n\t"
+      "adox %[high], %[low]\n\t"
+      "notq %[low]\n\t"
+      "adcx 8(%[r]), %[low]\n\t"
+      "movq %[low], 8(%[r])\n\t"
+      "mulx 16(%[a]), %[low], %[high]\n\t"
+      "adox %[borrow], %[low]\n\t"
+      "notq %[low]\n\t"
+      "adcx 16(%[r]), %[low]\n\t"
+      "movq %[low], 16(%[r])\n\t"
+      "mulx 24(%[a]), %[low], %[borrow]\n\t"
+      "adox %[high], %[low]\n\t"
+      "notq %[low]\n\t"
+      "adcx 24(%[r]), %[low]\n\t"
+      "movq %[low], 24(%[r])\n\t"
+      "leaq 32(%[a]), %[a]\n\t"
+      "leaq 32(%[r]), %[r]\n\t"
+      "leaq -1(%[blocks]), %[blocks]\n\t"
+      "jrcxz 2f\n\t"
+      "jmp 1b\n"
+      "2:\n\t"
+      "movl $0, %k[low]\n\t"
+      "adox %[low], %[borrow]\n\t"
+      "cmc\n\t"
+      "adcx %[low], %[borrow]\n\t"
+      : [borrow] "+&r"(borrow), [low] "=&r"(low), [high] "=&r"(high),
+        [a] "+&r"(a), [r] "+&r"(r), [blocks] "+&c"(blocks)
+      : "d"(b)
+      : "cc", "memory");
+  return borrow;
+}
+
+LimbKernels const kAdxKernels = {
+    .mul_one     = AdxMulOne,
+    .add_mul_one = AdxAddMulOne,
+    .sub_mul_one = AdxSubMulOne,
+};
+
+bool SupportsAdx() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("adx") and __builtin_cpu_supports("bmi2");
+}
+
+#endif
+
+}  // namespace
+
+LimbKernels const *AdxLimbKernels() {
+#if defined(__x86_64__) and (defined(__GNUC__) or defined(__clang__))
+  static bool const supported = SupportsAdx();
+  return supported ? &kAdxKernels : nullptr;
+#else
+  return nullptr;
+#endif
+}
+
+LimbKernels const &SelectedLimbKernels() {
+  static LimbKernels const &kernels = []() -> LimbKernels const & {
+    if (LimbKernels const *adx = AdxLimbKernels()) { return *adx; }
+    return kPortableKernels;
+  }();
+  return kernels;
+}
+
+}  // namespace chalk::internal_integer
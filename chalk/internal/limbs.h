@@ -0,0 +1,289 @@
+#ifndef CHALK_INTERNAL_LIMBS_H
+#define CHALK_INTERNAL_LIMBS_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "absl/numeric/int128.h"
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+// Kernels operating on little-endian arrays of 64-bit limbs representing
+// non-negative integers. Lengths are passed explicitly and sign handling is the
+// responsibility of the caller. Unless stated otherwise, an output may alias an
+// input exactly, but may not otherwise overlap with it.
+namespace chalk::internal_integer {
+
+// Returns the low and high limbs of the full product `a * b`.
+inline std::pair<uint64_t, uint64_t> MultiplyLimbs(uint64_t a, uint64_t b) {
+  absl::uint128 result = a;
+  result *= b;
+  return std::make_pair(absl::Uint128Low64(result),
+                        absl::Uint128High64(result));
+}
+
+// Returns the quotient and remainder of `(high * 2^64 + low) / d`. Requires
+// `high < d` so that the quotient fits in a single limb.
+inline std::pair<uint64_t, uint64_t> DivideLimbs(uint64_t high, uint64_t low,
+                                                 uint64_t d) {
+  assert(high < d);
+  absl::uint128 numerator = absl::MakeUint128(high, low);
+  return std::make_pair(absl::Uint128Low64(numerator / d),
+                        absl::Uint128Low64(numerator % d));
+}
+
+// Returns `a + b + carry` modulo 2^64, setting `carry` to the carry out.
+// Requires `carry` to be zero or one.
+inline uint64_t AddWithCarry(uint64_t a, uint64_t b, uint64_t &carry) {
+  uint64_t sum    = a + b;
+  uint64_t result = sum + carry;
+  carry           = (sum < a) | (result < sum);
+  return result;
+}
+
+// Returns `a - b - borrow` modulo 2^64, setting `borrow` to the borrow out.
+// Requires `borrow` to be zero or one.
+inline uint64_t SubtractWithBorrow(uint64_t a, uint64_t b, uint64_t &borrow) {
+  uint64_t difference = a - b;
+  uint64_t result     = difference - borrow;
+  borrow              = (a < b) | (difference < borrow);
+  return result;
+}
+
+// Returns the number of limbs in `a[0, n)` once leading zero limbs are
+// discarded.
+inline size_t Normalized(uint64_t const *a, size_t n) {
+  while (n > 0 and a[n - 1] == 0) { --n; }
+  return n;
+}
+
+// Returns a negative number, zero, or a positive number according to whether
+// `a[0, n)` is less than, equal to, or greater than `b[0, n)`.
+inline int Compare(uint64_t const *a, uint64_t const *b, size_t n) {
+  while (n-- > 0) {
+    if (a[n] != b[n]) { return a[n] < b[n] ? -1 : 1; }
+  }
+  return 0;
+}
+
+// As above, but for operands of possibly differing lengths which may have
+// leading zero limbs.
+inline int Compare(uint64_t const *a, size_t an, uint64_t const *b,
+                   size_t bn) {
+  an = Normalized(a, an);
+  bn = Normalized(b, bn);
+  if (an != bn) { return an < bn ? -1 : 1; }
+  return Compare(a, b, an);
+}
+
+// Sets `r[0, n)` to `a[0, n) + b[0, n)` and returns the carry out.
+inline uint64_t AddN(uint64_t *r, uint64_t const *a, uint64_t const *b,
+                     size_t n) {
+#if defined(__x86_64__)
+  // The intrinsic keeps the carry in the flags register from one limb to the
+  // next, which compilers do not manage for the portable loop below.
+  unsigned char carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    unsigned long long sum;
+    carry = _addcarry_u64(carry, a[i], b[i], &sum);
+    r[i]  = sum;
+  }
+  return carry;
+#else
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; ++i) { r[i] = AddWithCarry(a[i], b[i], carry); }
+  return carry;
+#endif
+}
+
+// Sets `r[0, n)` to `a[0, n) + b` and returns the carry out. When `r` and `a`
+// are the same array, stops as soon as the carry has been absorbed.
+inline uint64_t AddOne(uint64_t *r, uint64_t const *a, size_t n, uint64_t b) {
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t sum = a[i] + b;
+    b            = sum < b;
+    r[i]         = sum;
+    if (b == 0) {
+      if (r != a) { std::copy(a + i + 1, a + n, r + i + 1); }
+      return 0;
+    }
+  }
+  return b;
+}
+
+// Sets `r[0, an)` to `a[0, an) + b[0, bn)` and returns the carry out. Requires
+// `an >= bn`.
+inline uint64_t Add(uint64_t *r, uint64_t const *a, size_t an,
+                    uint64_t const *b, size_t bn) {
+  uint64_t carry = AddN(r, a, b, bn);
+  return AddOne(r + bn, a + bn, an - bn, carry);
+}
+
+// Sets `r[0, n)` to `a[0, n) - b[0, n)` and returns the borrow out.
+inline uint64_t SubN(uint64_t *r, uint64_t const *a, uint64_t const *b,
+                     size_t n) {
+#if defined(__x86_64__)
+  unsigned char borrow = 0;
+  for (size_t i = 0; i < n; ++i) {
+    unsigned long long difference;
+    borrow = _subborrow_u64(borrow, a[i], b[i], &difference);
+    r[i]   = difference;
+  }
+  return borrow;
+#else
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < n; ++i) {
+    r[i] = SubtractWithBorrow(a[i], b[i], borrow);
+  }
+  return borrow;
+#endif
+}
+
+// Sets `r[0, n)` to `a[0, n) - b` and returns the borrow out. When `r` and `a`
+// are the same array, stops as soon as the borrow has been absorbed.
+inline uint64_t SubOne(uint64_t *r, uint64_t const *a, size_t n, uint64_t b) {
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t limb = a[i];
+    r[i]          = limb - b;
+    b             = limb < b;
+    if (b == 0) {
+      if (r != a) { std::copy(a + i + 1, a + n, r + i + 1); }
+      return 0;
+    }
+  }
+  return b;
+}
+
+// Sets `r[0, an)` to `a[0, an) - b[0, bn)` and returns the borrow out. Requires
+// `an >= bn`.
+inline uint64_t Sub(uint64_t *r, uint64_t const *a, size_t an,
+                    uint64_t const *b, size_t bn) {
+  uint64_t borrow = SubN(r, a, b, bn);
+  return SubOne(r + bn, a + bn, an - bn, borrow);
+}
+
+// Sets `r[0, n)` to the low `n` limbs of `a[0, n) * b` and returns the high
+// limb.
+inline uint64_t PortableMulOne(uint64_t *r, uint64_t const *a, size_t n,
+                               uint64_t b) {
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    auto [low, high] = MultiplyLimbs(a[i], b);
+    low += carry;
+    carry = high + (low < carry);
+    r[i]  = low;
+  }
+  return carry;
+}
+
+// Adds `a[0, n) * b` to `r[0, n)` and returns the limb carried out.
+inline uint64_t PortableAddMulOne(uint64_t *r, uint64_t const *a, size_t n,
+                                  uint64_t b) {
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    auto [low, high] = MultiplyLimbs(a[i], b);
+    low += carry;
+    high += (low < carry);
+    uint64_t sum = r[i] + low;
+    carry        = high + (sum < low);
+    r[i]         = sum;
+  }
+  return carry;
+}
+
+// Subtracts `a[0, n) * b` from `r[0, n)` and returns the limb borrowed out.
+inline uint64_t PortableSubMulOne(uint64_t *r, uint64_t const *a, size_t n,
+                                  uint64_t b) {
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < n; ++i) {
+    auto [low, high] = MultiplyLimbs(a[i], b);
+    low += borrow;
+    high += (low < borrow);
+    uint64_t limb = r[i];
+    r[i]          = limb - low;
+    borrow        = high + (limb < low);
+  }
+  return borrow;
+}
+
+// Implementations of the single-limb multiplication kernels, with the same
+// contracts as the portable versions above.
+struct LimbKernels {
+  uint64_t (*mul_one)(uint64_t *r, uint64_t const *a, size_t n, uint64_t b);
+  uint64_t (*add_mul_one)(uint64_t *r, uint64_t const *a, size_t n,
+                          uint64_t b);
+  uint64_t (*sub_mul_one)(uint64_t *r, uint64_t const *a, size_t n,
+                          uint64_t b);
+};
+
+// Returns kernels using the ADX and BMI2 extensions (`mulx` with independent
+// carry chains through `adcx` and `adox`), or null if the processor does not
+// support them.
+LimbKernels const *AdxLimbKernels();
+
+// Returns the fastest kernels the processor supports, determined on first use.
+LimbKernels const &SelectedLimbKernels();
+
+// Operands shorter than this use the inlined portable kernels, for which the
+// cost of an indirect call would outweigh any gain.
+inline constexpr size_t kSelectedLimbKernelLength = 8;
+
+// Sets `r[0, n)` to the low `n` limbs of `a[0, n) * b` and returns the high
+// limb.
+inline uint64_t MulOne(uint64_t *r, uint64_t const *a, size_t n, uint64_t b) {
+  if (n < kSelectedLimbKernelLength) { return PortableMulOne(r, a, n, b); }
+  return SelectedLimbKernels().mul_one(r, a, n, b);
+}
+
+// Adds `a[0, n) * b` to `r[0, n)` and returns the limb carried out.
+inline uint64_t AddMulOne(uint64_t *r, uint64_t const *a, size_t n,
+                          uint64_t b) {
+  if (n < kSelectedLimbKernelLength) { return PortableAddMulOne(r, a, n, b); }
+  return SelectedLimbKernels().add_mul_one(r, a, n, b);
+}
+
+// Subtracts `a[0, n) * b` from `r[0, n)` and returns the limb borrowed out.
+inline uint64_t SubMulOne(uint64_t *r, uint64_t const *a, size_t n,
+                          uint64_t b) {
+  if (n < kSelectedLimbKernelLength) { return PortableSubMulOne(r, a, n, b); }
+  return SelectedLimbKernels().sub_mul_one(r, a, n, b);
+}
+
+// Sets `r[0, n)` to the low `n` limbs of `a[0, n) << shift` and returns the
+// bits shifted out. Requires `0 < shift < 64`. `r` may be `a`, or may overlap
+// it at any higher address.
+inline uint64_t ShiftLeft(uint64_t *r, uint64_t const *a, size_t n,
+                          int shift) {
+  assert(0 < shift and shift < 64);
+  if (n == 0) { return 0; }
+  uint64_t out = a[n - 1] >> (64 - shift);
+  for (size_t i = n - 1; i > 0; --i) {
+    r[i] = (a[i] << shift) | (a[i - 1] >> (64 - shift));
+  }
+  r[0] = a[0] << shift;
+  return out;
+}
+
+// Sets `r[0, n)` to `a[0, n) >> shift` and returns the bits shifted out, in
+// the high bits of the returned limb. Requires `0 < shift < 64`. `r` may be
+// `a`, or may overlap it at any lower address.
+inline uint64_t ShiftRight(uint64_t *r, uint64_t const *a, size_t n,
+                           int shift) {
+  assert(0 < shift and shift < 64);
+  if (n == 0) { return 0; }
+  uint64_t out = a[0] << (64 - shift);
+  for (size_t i = 0; i + 1 < n; ++i) {
+    r[i] = (a[i] >> shift) | (a[i + 1] << (64 - shift));
+  }
+  r[n - 1] = a[n - 1] >> shift;
+  return out;
+}
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_LIMBS_H
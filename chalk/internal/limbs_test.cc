@@ -0,0 +1,87 @@
+#include "chalk/internal/limbs.h"
+
+#include <random>
+#include <vector>
+
+#include "chalk/internal/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+// Checks each of `kernels` against the portable kernels on operands of every
+// length up to a few unrolled blocks.
+void ExpectMatchesPortable(LimbKernels const &kernels) {
+  std::mt19937_64 gen(0);
+  for (size_t n = 0; n < 40; ++n) {
+    for (int trial = 0; trial < 50; ++trial) {
+      std::vector<uint64_t> a = RandomLimbs(n, gen);
+      std::vector<uint64_t> r = RandomLimbs(n, gen);
+      uint64_t b = trial % 5 == 0 ? ~uint64_t{0} : gen();
+
+      std::vector<uint64_t> expected(n), actual(n);
+      EXPECT_EQ(kernels.mul_one(actual.data(), a.data(), n, b),
+                PortableMulOne(expected.data(), a.data(), n, b));
+      EXPECT_EQ(actual, expected);
+
+      expected = actual = r;
+      EXPECT_EQ(kernels.add_mul_one(actual.data(), a.data(), n, b),
+                PortableAddMulOne(expected.data(), a.data(), n, b));
+      EXPECT_EQ(actual, expected);
+
+      expected = actual = r;
+      EXPECT_EQ(kernels.sub_mul_one(actual.data(), a.data(), n, b),
+                PortableSubMulOne(expected.data(), a.data(), n, b));
+      EXPECT_EQ(actual, expected);
+    }
+  }
+}
+
+TEST(Limbs, AddAndSubtract) {
+  std::mt19937_64 gen(1);
+  for (size_t n = 0; n < 20; ++n) {
+    for (int trial = 0; trial < 50; ++trial) {
+      std::vector<uint64_t> a = RandomLimbs(n, gen);
+      std::vector<uint64_t> b = RandomLimbs(n, gen);
+      std::vector<uint64_t> sum(n), difference(n);
+      uint64_t carry  = AddN(sum.data(), a.data(), b.data(), n);
+      uint64_t borrow = SubN(difference.data(), sum.data(), b.data(), n);
+      EXPECT_EQ(difference, a);
+      EXPECT_EQ(carry, borrow);
+
+      uint64_t expected_carry = 0;
+      for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(sum[i], AddWithCarry(a[i], b[i], expected_carry));
+      }
+      EXPECT_EQ(carry, expected_carry);
+    }
+  }
+}
+
+TEST(Limbs, SelectedKernelsMatchPortable) {
+  ExpectMatchesPortable(SelectedLimbKernels());
+}
+
+TEST(Limbs, AdxKernelsMatchPortable) {
+  LimbKernels const *kernels = AdxLimbKernels();
+  if (kernels == nullptr) {
+    GTEST_SKIP() << "Processor does not support ADX and BMI2.";
+  }
+  ExpectMatchesPortable(*kernels);
+}
+
+TEST(Limbs, MultiplyAliasing) {
+  std::mt19937_64 gen(2);
+  for (size_t n : {3, 8, 13, 32}) {
+    std::vector<uint64_t> a = RandomLimbs(n, gen);
+    uint64_t b              = gen();
+    std::vector<uint64_t> expected(n);
+    uint64_t high = PortableMulOne(expected.data(), a.data(), n, b);
+    EXPECT_EQ(MulOne(a.data(), a.data(), n, b), high);
+    EXPECT_EQ(a, expected);
+  }
+}
+
+}  // namespace
+}  // namespace chalk::internal_integer
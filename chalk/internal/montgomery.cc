@@ -0,0 +1,31 @@
+#include "chalk/internal/montgomery.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "chalk/internal/limbs.h"
+
+namespace chalk::internal_integer {
+
+void MontgomeryReduce(uint64_t *r, uint64_t *t, uint64_t const *m, size_t n,
+                      uint64_t inverse) {
+  // Each row adds the multiple of `m` that clears the lowest remaining limb of
+  // `t`. The limb carried out of a row is added to the limb just above it, and
+  // the single bit carried out of that addition is deferred to the next row
+  // rather than propagated.
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t row_carry = AddMulOne(t + i, m, n, t[i] * inverse);
+    t[i + n]           = AddWithCarry(t[i + n], row_carry, carry);
+  }
+
+  // The quotient `t[n, 2n) + carry * 2^(64 * n)` is less than `2 * m`, so a
+  // single subtraction suffices.
+  if (carry != 0 or Compare(t + n, m, n) >= 0) {
+    SubN(r, t + n, m, n);
+  } else if (r != t + n) {
+    std::copy(t + n, t + 2 * n, r);
+  }
+}
+
+}  // namespace chalk::internal_integer
@@ -0,0 +1,87 @@
+#ifndef CHALK_INTERNAL_MONTGOMERY_H
+#define CHALK_INTERNAL_MONTGOMERY_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "chalk/internal/limbs.h"
+
+namespace chalk::internal_integer {
+
+// Returns `-m^-1 mod 2^64`. Requires `m` to be odd.
+constexpr uint64_t NegatedInverse(uint64_t m) {
+  assert(m % 2 == 1);
+  // Every odd `m` is its own inverse modulo 8, and each Newton step doubles the
+  // number of correct low bits.
+  uint64_t inverse = m;
+  for (int i = 0; i < 5; ++i) { inverse *= 2 - m * inverse; }
+  return 0 - inverse;
+}
+
+// Arithmetic modulo a single-limb odd modulus `p < 2^63`, with `R = 2^64`.
+// Values are kept in the range `[0, p)`. `Multiply` divides by `R`, so the
+// product of two values in Montgomery form (i.e., scaled by `R`) is again in
+// Montgomery form, and the product of a value in Montgomery form with one in
+// the standard representation is an ordinary modular product.
+struct Montgomery64 {
+  constexpr explicit Montgomery64(uint64_t modulus)
+      : modulus(modulus), negative_inverse(NegatedInverse(modulus)) {
+    assert(modulus < uint64_t{1} << 63);
+    // `R^2 mod p`, by doubling `R mod p` sixty-four times.
+    uint64_t r = (~modulus + 1) % modulus;
+    for (int i = 0; i < 64; ++i) { r = Add(r, r); }
+    r_squared = r;
+  }
+
+  // Since `p < 2^63`, the sum of two values never overflows a limb.
+  constexpr uint64_t Add(uint64_t a, uint64_t b) const {
+    uint64_t sum = a + b;
+    return sum >= modulus ? sum - modulus : sum;
+  }
+  constexpr uint64_t Subtract(uint64_t a, uint64_t b) const {
+    return a >= b ? a - b : a + (modulus - b);
+  }
+
+  // Returns `a * b / R` modulo `p`.
+  uint64_t Multiply(uint64_t a, uint64_t b) const {
+    auto [low, high]     = MultiplyLimbs(a, b);
+    uint64_t m           = low * negative_inverse;
+    auto [m_low, m_high] = MultiplyLimbs(m, modulus);
+    // `low + m_low` is zero modulo 2^64 by construction, and carries exactly
+    // when `low` is non-zero.
+    uint64_t result = high + m_high + (low != 0);
+    return result >= modulus ? result - modulus : result;
+  }
+
+  uint64_t ToMontgomery(uint64_t a) const { return Multiply(a, r_squared); }
+  uint64_t FromMontgomery(uint64_t a) const { return Multiply(a, 1); }
+
+  // Returns `base^exponent` in Montgomery form, given `base` in Montgomery
+  // form.
+  uint64_t Power(uint64_t base, uint64_t exponent) const {
+    uint64_t result = ToMontgomery(1);
+    for (; exponent != 0; exponent >>= 1) {
+      if (exponent & 1) { result = Multiply(result, base); }
+      base = Multiply(base, base);
+    }
+    return result;
+  }
+
+  uint64_t modulus;
+  // `-p^-1 mod 2^64` and `R^2 mod p`.
+  uint64_t negative_inverse;
+  uint64_t r_squared = 0;
+};
+
+// Sets `r[0, n)` to `t[0, 2n) * 2^(-64 * n) mod m[0, n)` using Montgomery's
+// REDC, overwriting `t`. Requires `m` to be odd with a non-zero top limb,
+// `inverse` to be `NegatedInverse(m[0])`, and `t < m * 2^(64 * n)`, as holds
+// for the product of two values less than `m`. `r` may overlap `t` only if it
+// is `t + n`.
+void MontgomeryReduce(uint64_t *r, uint64_t *t, uint64_t const *m, size_t n,
+                      uint64_t inverse);
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_MONTGOMERY_H
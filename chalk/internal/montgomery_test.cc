@@ -0,0 +1,94 @@
+#include "chalk/internal/montgomery.h"
+
+#include <random>
+#include <vector>
+
+#include "chalk/internal/divide.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/multiply.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+// Returns a random value less than `m`, or one less than `m` if `largest`.
+std::vector<uint64_t> RandomBelow(std::vector<uint64_t> const &m,
+                                  std::mt19937_64 &gen, bool largest = false) {
+  std::vector<uint64_t> result = m;
+  if (largest) {
+    SubOne(result.data(), result.data(), result.size(), 1);
+  } else {
+    for (uint64_t &limb : result) { limb = gen(); }
+    result.back() = gen() % m.back();
+  }
+  return result;
+}
+
+std::vector<uint64_t> Remainder(std::vector<uint64_t> const &a,
+                                std::vector<uint64_t> const &m) {
+  std::vector<uint64_t> q(a.size() - m.size() + 1), r(m.size());
+  DivRem(q.data(), r.data(), a.data(), a.size(), m.data(), m.size());
+  return r;
+}
+
+// Checks that reducing `a * b` yields `r < m` with `r * 2^(64 * n) = a * b`
+// modulo `m`.
+void ExpectValidReduction(std::vector<uint64_t> const &a,
+                          std::vector<uint64_t> const &b,
+                          std::vector<uint64_t> const &m) {
+  size_t n = m.size();
+  std::vector<uint64_t> t(2 * n), r(n);
+  Multiply(t.data(), a.data(), n, b.data(), n);
+  std::vector<uint64_t> product = t;
+  MontgomeryReduce(r.data(), t.data(), m.data(), n, NegatedInverse(m[0]));
+  EXPECT_LT(Compare(r.data(), m.data(), n), 0);
+
+  std::vector<uint64_t> shifted(n, 0);
+  shifted.insert(shifted.end(), r.begin(), r.end());
+  EXPECT_EQ(Remainder(shifted, m), Remainder(product, m));
+}
+
+TEST(NegatedInverse, Random) {
+  std::mt19937_64 gen(0);
+  EXPECT_EQ(NegatedInverse(1), ~uint64_t{0});
+  EXPECT_EQ(NegatedInverse(~uint64_t{0}), 1u);
+  for (int trial = 0; trial < 1000; ++trial) {
+    uint64_t m = gen() | 1;
+    EXPECT_EQ(m * NegatedInverse(m), ~uint64_t{0});
+  }
+}
+
+TEST(MontgomeryReduce, Random) {
+  std::mt19937_64 gen(0);
+  for (size_t n : {1, 2, 3, 8, 40, 100}) {
+    for (int trial = 0; trial < 5; ++trial) {
+      std::vector<uint64_t> m(n);
+      for (uint64_t &limb : m) { limb = gen(); }
+      m[0] |= 1;
+      m.back() |= 1;
+      ExpectValidReduction(RandomBelow(m, gen), RandomBelow(m, gen), m);
+      ExpectValidReduction(RandomBelow(m, gen, true), RandomBelow(m, gen), m);
+    }
+  }
+}
+
+TEST(MontgomeryReduce, ExtremeModuli) {
+  // Moduli of all ones maximize the deferred carries, and moduli with a small
+  // top limb the final subtraction.
+  std::mt19937_64 gen(0);
+  for (size_t n : {1, 2, 5, 33}) {
+    std::vector<uint64_t> ones(n, ~uint64_t{0});
+    std::vector<uint64_t> small_top(n, 0);
+    small_top[0]     = 1;
+    small_top.back() = 1;
+    for (auto const &m : {ones, small_top}) {
+      std::vector<uint64_t> largest = RandomBelow(m, gen, true);
+      ExpectValidReduction(largest, largest, m);
+      ExpectValidReduction(largest, RandomBelow(m, gen), m);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace chalk::internal_integer
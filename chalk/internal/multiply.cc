@@ -0,0 +1,449 @@
+#include "chalk/internal/multiply.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <vector>
+
+#include "chalk/integer_thresholds.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/ntt.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+constexpr size_t kMinimumKaratsubaSize = 2;
+constexpr size_t kMinimumToom3Size     = 9;
+
+size_t KaratsubaThreshold() {
+  return std::max(GlobalIntegerThresholds().karatsuba_multiplication,
+                  kMinimumKaratsubaSize);
+}
+
+size_t KaratsubaSquaringThreshold() {
+  return std::max(GlobalIntegerThresholds().karatsuba_squaring,
+                  kMinimumKaratsubaSize);
+}
+
+size_t Toom3Threshold() {
+  return std::max(GlobalIntegerThresholds().toom3_multiplication,
+                  kMinimumToom3Size);
+}
+
+size_t NttThreshold() { return GlobalIntegerThresholds().ntt_multiplication; }
+
+// Returns the number of scratch limbs `KaratsubaImpl` needs for operands of `n`
+// limbs, including those needed by its recursive calls. Since squaring needs
+// less scratch per level, this also suffices for `KaratsubaSquareImpl` with the
+// smaller of the two Karatsuba thresholds.
+size_t KaratsubaScratchSize(size_t n) {
+  size_t size = 0;
+  size_t threshold =
+      std::min(KaratsubaThreshold(), KaratsubaSquaringThreshold());
+  while (n >= threshold) {
+    size_t m = (n + 1) / 2;
+    size += 6 * m + 1;
+    n = m;
+  }
+  return size;
+}
+
+// Sets `r[0, an)` to the absolute value of `a[0, an) - b[0, bn)` and returns
+// whether that difference is negative. Requires `an >= bn`.
+bool AbsoluteDifference(uint64_t *r, uint64_t const *a, size_t an,
+                        uint64_t const *b, size_t bn) {
+  if (Compare(a, an, b, bn) >= 0) {
+    Sub(r, a, an, b, bn);
+    return false;
+  }
+  // Here `b > a`, so the limbs `a[bn, an)` must all be zero.
+  SubN(r, b, a, bn);
+  std::fill(r + bn, r + an, 0);
+  return true;
+}
+
+void KaratsubaImpl(uint64_t *r, uint64_t const *a, uint64_t const *b, size_t n,
+                   uint64_t *scratch);
+void KaratsubaSquareImpl(uint64_t *r, uint64_t const *a, size_t n,
+                         uint64_t *scratch);
+
+// Sets `r[0, 2n)` to `a[0, n) * b[0, n)` with the algorithm appropriate for
+// `n`. `scratch` must have at least `KaratsubaScratchSize(n)` limbs.
+void MultiplyBalanced(uint64_t *r, uint64_t const *a, uint64_t const *b,
+                      size_t n, uint64_t *scratch) {
+  if (n < KaratsubaThreshold()) {
+    SchoolbookMultiply(r, a, n, b, n);
+  } else if (n < Toom3Threshold()) {
+    KaratsubaImpl(r, a, b, n, scratch);
+  } else if (n < NttThreshold()) {
+    Toom3Multiply(r, a, b, n);
+  } else {
+    NttMultiply(r, a, n, b, n);
+  }
+}
+
+// As `MultiplyBalanced`, but squaring `a[0, n)`.
+void SquareBalanced(uint64_t *r, uint64_t const *a, size_t n,
+                    uint64_t *scratch) {
+  if (n < KaratsubaSquaringThreshold()) {
+    SchoolbookSquare(r, a, n);
+  } else if (n < Toom3Threshold()) {
+    KaratsubaSquareImpl(r, a, n, scratch);
+  } else if (n < NttThreshold()) {
+    Toom3Square(r, a, n);
+  } else {
+    NttSquare(r, a, n);
+  }
+}
+
+// Splitting each operand as `x0 + x1 * B^m`, computes the product from
+// `x0 * y0`, `x1 * y1` and `|x0 - x1| * |y0 - y1|`, whose signed value is
+// `x0 * y0 + x1 * y1 - (x0 * y1 + x1 * y0)`.
+void KaratsubaImpl(uint64_t *r, uint64_t const *a, uint64_t const *b, size_t n,
+                   uint64_t *scratch) {
+  size_t m = (n + 1) / 2;
+  size_t h = n - m;
+
+  uint64_t *a_difference = scratch;
+  uint64_t *b_difference = a_difference + m;
+  uint64_t *product      = b_difference + m;
+  uint64_t *middle       = product + 2 * m;
+  uint64_t *rest         = middle + 2 * m + 1;
+
+  MultiplyBalanced(r, a, b, m, rest);
+  MultiplyBalanced(r + 2 * m, a + m, b + m, h, rest);
+
+  bool negative = AbsoluteDifference(a_difference, a, m, a + m, h) !=
+                  AbsoluteDifference(b_difference, b, m, b + m, h);
+  MultiplyBalanced(product, a_difference, b_difference, m, rest);
+
+  middle[2 * m] = Add(middle, r, 2 * m, r + 2 * m, 2 * h);
+  if (negative) {
+    middle[2 * m] += AddN(middle, middle, product, 2 * m);
+  } else {
+    middle[2 * m] -= SubN(middle, middle, product, 2 * m);
+  }
+
+  // The middle term may only be wider than the space remaining above `B^m` if
+  // its excess limbs are zero.
+  size_t middle_size = std::min(2 * m + 1, 2 * n - m);
+  [[maybe_unused]] uint64_t carry =
+      Add(r + m, r + m, 2 * n - m, middle, middle_size);
+  assert(carry == 0);
+}
+
+// Splitting `a` as `x0 + x1 * B^m`, computes the square from `x0^2`, `x1^2` and
+// `(x0 - x1)^2`, so that the cross term `2 * x0 * x1` is always their
+// difference and no sign needs tracking.
+void KaratsubaSquareImpl(uint64_t *r, uint64_t const *a, size_t n,
+                         uint64_t *scratch) {
+  size_t m = (n + 1) / 2;
+  size_t h = n - m;
+
+  uint64_t *difference = scratch;
+  uint64_t *product    = difference + m;
+  uint64_t *middle     = product + 2 * m;
+  uint64_t *rest       = middle + 2 * m + 1;
+
+  SquareBalanced(r, a, m, rest);
+  SquareBalanced(r + 2 * m, a + m, h, rest);
+
+  AbsoluteDifference(difference, a, m, a + m, h);
+  SquareBalanced(product, difference, m, rest);
+
+  middle[2 * m] = Add(middle, r, 2 * m, r + 2 * m, 2 * h);
+  middle[2 * m] -= SubN(middle, middle, product, 2 * m);
+
+  size_t middle_size = std::min(2 * m + 1, 2 * n - m);
+  [[maybe_unused]] uint64_t carry =
+      Add(r + m, r + m, 2 * n - m, middle, middle_size);
+  assert(carry == 0);
+}
+
+// A signed integer represented by a sign and a magnitude without leading zero
+// limbs, used for the intermediate values of Toom-3, which may be negative.
+struct SignedValue {
+  SignedValue() = default;
+  SignedValue(uint64_t const *a, size_t n)
+      : magnitude(a, a + Normalized(a, n)) {}
+
+  void Normalize() {
+    magnitude.resize(Normalized(magnitude.data(), magnitude.size()));
+    if (magnitude.empty()) { negative = false; }
+  }
+
+  std::vector<uint64_t> magnitude;
+  bool negative = false;
+};
+
+SignedValue AddSigned(SignedValue const &x, SignedValue const &y,
+                      bool negate_y = false) {
+  bool y_negative = y.negative != negate_y;
+  SignedValue const *larger  = &x;
+  SignedValue const *smaller = &y;
+  if (x.magnitude.size() < y.magnitude.size()) { std::swap(larger, smaller); }
+
+  SignedValue result;
+  size_t size = larger->magnitude.size();
+  if (x.negative == y_negative) {
+    result.magnitude.resize(size + 1);
+    result.magnitude[size] =
+        Add(result.magnitude.data(), larger->magnitude.data(), size,
+            smaller->magnitude.data(), smaller->magnitude.size());
+    result.negative = x.negative;
+  } else {
+    result.magnitude.resize(size);
+    bool flipped = AbsoluteDifference(
+        result.magnitude.data(), larger->magnitude.data(), size,
+        smaller->magnitude.data(), smaller->magnitude.size());
+    bool larger_negative = larger == &x ? x.negative : y_negative;
+    result.negative      = larger_negative != flipped;
+  }
+  result.Normalize();
+  return result;
+}
+
+SignedValue SubtractSigned(SignedValue const &x, SignedValue const &y) {
+  return AddSigned(x, y, true);
+}
+
+SignedValue MultiplySigned(SignedValue const &x, SignedValue const &y) {
+  SignedValue result;
+  size_t xn = x.magnitude.size();
+  size_t yn = y.magnitude.size();
+  if (xn == 0 or yn == 0) { return result; }
+  result.magnitude.resize(xn + yn);
+  Multiply(result.magnitude.data(), x.magnitude.data(), xn, y.magnitude.data(),
+           yn);
+  result.negative = x.negative != y.negative;
+  result.Normalize();
+  return result;
+}
+
+void ShiftLeftOne(SignedValue &x) {
+  uint64_t carry = 0;
+  for (uint64_t &limb : x.magnitude) {
+    uint64_t next = limb >> 63;
+    limb          = (limb << 1) | carry;
+    carry         = next;
+  }
+  if (carry) { x.magnitude.push_back(carry); }
+}
+
+// Divides `x` by two. Requires `x` to be even.
+void DivideExactlyByTwo(SignedValue &x) {
+  size_t n = x.magnitude.size();
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t high  = i + 1 < n ? x.magnitude[i + 1] : 0;
+    x.magnitude[i] = (x.magnitude[i] >> 1) | (high << 63);
+  }
+  x.Normalize();
+}
+
+// Divides `x` by three. Requires `x` to be divisible by three. Since the
+// division is exact, each quotient limb can be found by multiplying by the
+// inverse of three modulo 2^64 rather than by dividing.
+void DivideExactlyByThree(SignedValue &x) {
+  constexpr uint64_t kInverseOfThree = 0xaaaaaaaaaaaaaaab;
+  uint64_t borrow                    = 0;
+  for (uint64_t &limb : x.magnitude) {
+    uint64_t difference = limb - borrow;
+    uint64_t next       = limb < borrow;
+    limb                = difference * kInverseOfThree;
+    borrow              = next + MultiplyLimbs(limb, 3).second;
+  }
+  assert(borrow == 0);
+  x.Normalize();
+}
+
+// Adds the non-negative `x` to `r[0, n)`. Requires that no carry out occurs.
+void AccumulateInto(uint64_t *r, size_t n, SignedValue const &x) {
+  assert(not x.negative);
+  assert(x.magnitude.size() <= n);
+  [[maybe_unused]] uint64_t carry =
+      Add(r, r, n, x.magnitude.data(), x.magnitude.size());
+  assert(carry == 0);
+}
+
+}  // namespace
+
+void SchoolbookMultiply(uint64_t *r, uint64_t const *a, size_t an,
+                        uint64_t const *b, size_t bn) {
+  if (an < bn) {
+    std::swap(a, b);
+    std::swap(an, bn);
+  }
+  r[an] = MulOne(r, a, an, b[0]);
+  for (size_t i = 1; i < bn; ++i) {
+    r[an + i] = AddMulOne(r + i, a, an, b[i]);
+  }
+}
+
+// Accumulates the products `a[i] * a[j]` for `i < j` into `r`, and then
+// doubles them while adding the squares `a[i]^2` of the diagonal in a single
+// pass.
+void SchoolbookSquare(uint64_t *r, uint64_t const *a, size_t n) {
+  r[0]         = 0;
+  r[2 * n - 1] = 0;
+  r[n]         = MulOne(r + 1, a + 1, n - 1, a[0]);
+  for (size_t i = 1; i + 1 < n; ++i) {
+    r[n + i] = AddMulOne(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+  }
+
+  uint64_t carry = 0;
+  uint64_t top   = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t low_limb     = r[2 * i];
+    uint64_t high_limb    = r[2 * i + 1];
+    uint64_t doubled_low  = (low_limb << 1) | top;
+    uint64_t doubled_high = (high_limb << 1) | (low_limb >> 63);
+    top                   = high_limb >> 63;
+
+    auto [low, high] = MultiplyLimbs(a[i], a[i]);
+    r[2 * i]         = AddWithCarry(doubled_low, low, carry);
+    r[2 * i + 1]     = AddWithCarry(doubled_high, high, carry);
+  }
+  assert(carry == 0 and top == 0);
+}
+
+void KaratsubaMultiply(uint64_t *r, uint64_t const *a, uint64_t const *b,
+                       size_t n) {
+  assert(n >= kMinimumKaratsubaSize);
+  std::vector<uint64_t> scratch(KaratsubaScratchSize(n) + 6 * n + 1);
+  KaratsubaImpl(r, a, b, n, scratch.data());
+}
+
+void KaratsubaSquare(uint64_t *r, uint64_t const *a, size_t n) {
+  assert(n >= kMinimumKaratsubaSize);
+  std::vector<uint64_t> scratch(KaratsubaScratchSize(n) + 6 * n + 1);
+  KaratsubaSquareImpl(r, a, n, scratch.data());
+}
+
+// Splitting each operand as `x0 + x1 * B^k + x2 * B^2k`, evaluates the
+// corresponding polynomials at 0, 1, -1, -2 and infinity, multiplies
+// pointwise, and interpolates the product polynomial, whose coefficients are
+// then summed at the appropriate offsets. When `a` and `b` are the same array,
+// it is evaluated once and the pointwise products are squares.
+void Toom3Multiply(uint64_t *r, uint64_t const *a, uint64_t const *b,
+                   size_t n) {
+  assert(n >= kMinimumToom3Size);
+  size_t k = (n + 2) / 3;
+
+  auto evaluate = [&](uint64_t const *x) {
+    SignedValue x0(x, k), x1(x + k, k), x2(x + 2 * k, n - 2 * k);
+    SignedValue even         = AddSigned(x0, x2);
+    SignedValue at_one       = AddSigned(even, x1);
+    SignedValue at_minus_one = SubtractSigned(even, x1);
+    SignedValue at_minus_two = AddSigned(at_minus_one, x2);
+    ShiftLeftOne(at_minus_two);
+    at_minus_two = SubtractSigned(at_minus_two, x0);
+    return std::array<SignedValue, 5>{std::move(x0), std::move(at_one),
+                                      std::move(at_minus_one),
+                                      std::move(at_minus_two), std::move(x2)};
+  };
+  std::array<SignedValue, 5> a_values = evaluate(a);
+  std::array<SignedValue, 5> distinct_b_values;
+  if (a != b) { distinct_b_values = evaluate(b); }
+  auto const &b_values = a == b ? a_values : distinct_b_values;
+
+  SignedValue r0   = MultiplySigned(a_values[0], b_values[0]);
+  SignedValue r1   = MultiplySigned(a_values[1], b_values[1]);
+  SignedValue r_m1 = MultiplySigned(a_values[2], b_values[2]);
+  SignedValue r_m2 = MultiplySigned(a_values[3], b_values[3]);
+  SignedValue r4   = MultiplySigned(a_values[4], b_values[4]);
+
+  SignedValue r3 = SubtractSigned(r_m2, r1);
+  DivideExactlyByThree(r3);
+  r1 = SubtractSigned(r1, r_m1);
+  DivideExactlyByTwo(r1);
+  SignedValue r2 = SubtractSigned(r_m1, r0);
+  r3             = SubtractSigned(r2, r3);
+  DivideExactlyByTwo(r3);
+  SignedValue twice_r4 = r4;
+  ShiftLeftOne(twice_r4);
+  r3 = AddSigned(r3, twice_r4);
+  r2 = SubtractSigned(AddSigned(r2, r1), r4);
+  r1 = SubtractSigned(r1, r3);
+
+  std::fill(r, r + 2 * n, 0);
+  AccumulateInto(r, 2 * n, r0);
+  AccumulateInto(r + k, 2 * n - k, r1);
+  AccumulateInto(r + 2 * k, 2 * n - 2 * k, r2);
+  AccumulateInto(r + 3 * k, 2 * n - 3 * k, r3);
+  AccumulateInto(r + 4 * k, 2 * n - 4 * k, r4);
+}
+
+void Toom3Square(uint64_t *r, uint64_t const *a, size_t n) {
+  Toom3Multiply(r, a, a, n);
+}
+
+void Square(uint64_t *r, uint64_t const *a, size_t n) {
+  if (n < KaratsubaSquaringThreshold()) {
+    SchoolbookSquare(r, a, n);
+    return;
+  }
+  if (n >= NttThreshold()) {
+    NttSquare(r, a, n);
+    return;
+  }
+  std::vector<uint64_t> scratch(KaratsubaScratchSize(n));
+  SquareBalanced(r, a, n, scratch.data());
+}
+
+void Multiply(uint64_t *r, uint64_t const *a, size_t an, uint64_t const *b,
+              size_t bn) {
+  if (a == b and an == bn) {
+    Square(r, a, an);
+    return;
+  }
+  if (an < bn) {
+    std::swap(a, b);
+    std::swap(an, bn);
+  }
+  if (bn < KaratsubaThreshold()) {
+    SchoolbookMultiply(r, a, an, b, bn);
+    return;
+  }
+  if (bn >= NttThreshold()) {
+    NttMultiply(r, a, an, b, bn);
+    return;
+  }
+
+  std::vector<uint64_t> scratch(KaratsubaScratchSize(bn));
+  MultiplyBalanced(r, a, b, bn, scratch.data());
+  if (an == bn) { return; }
+
+  // Unbalanced operands are multiplied one `bn`-limb chunk of `a` at a time,
+  // so that every chunk benefits from the balanced algorithms.
+  std::vector<uint64_t> product(2 * bn);
+  for (size_t offset = bn; offset < an; offset += bn) {
+    size_t chunk = std::min(bn, an - offset);
+    if (chunk == bn) {
+      MultiplyBalanced(product.data(), a + offset, b, bn, scratch.data());
+    } else {
+      Multiply(product.data(), b, bn, a + offset, chunk);
+    }
+    std::fill(r + offset + bn, r + offset + bn + chunk, 0);
+    [[maybe_unused]] uint64_t carry =
+        Add(r + offset, r + offset, bn + chunk, product.data(), bn + chunk);
+    assert(carry == 0);
+  }
+}
+
+size_t MultiplyScratchSize(size_t n) { return KaratsubaScratchSize(n); }
+
+void MultiplyWithScratch(uint64_t *r, uint64_t const *a, uint64_t const *b,
+                         size_t n, uint64_t *scratch) {
+  if (a == b) {
+    SquareBalanced(r, a, n, scratch);
+  } else {
+    MultiplyBalanced(r, a, b, n, scratch);
+  }
+}
+
+void SquareWithScratch(uint64_t *r, uint64_t const *a, size_t n,
+                       uint64_t *scratch) {
+  SquareBalanced(r, a, n, scratch);
+}
+
+}  // namespace chalk::internal_integer
@@ -0,0 +1,61 @@
+#ifndef CHALK_INTERNAL_MULTIPLY_H
+#define CHALK_INTERNAL_MULTIPLY_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chalk::internal_integer {
+
+// Sets `r[0, an + bn)` to the product of `a[0, an)` and `b[0, bn)`, choosing an
+// algorithm according to `GlobalIntegerThresholds()`. Requires `an` and `bn` to
+// be positive and `r` not to overlap either operand. If the operands are the
+// same array of the same length, the product is computed with `Square`.
+void Multiply(uint64_t *r, uint64_t const *a, size_t an, uint64_t const *b,
+              size_t bn);
+
+// Sets `r[0, 2n)` to the square of `a[0, n)`. Each algorithm computes the
+// products of distinct parts of `a` once rather than twice, making squaring
+// roughly one and a half times faster than multiplication. Requires `n` to be
+// positive and `r` not to overlap `a`.
+void Square(uint64_t *r, uint64_t const *a, size_t n);
+
+// Counterparts of `Multiply` and `Square` for operands of equal length `n`,
+// taking the temporary storage of Karatsuba's algorithm from `scratch`, which
+// must have room for `MultiplyScratchSize(n)` limbs as computed under the
+// current thresholds. Products below the Toom-3 threshold then make no
+// allocations; Toom-3 and number-theoretic transforms still allocate their own
+// temporaries. Intended for callers multiplying repeatedly at one size.
+size_t MultiplyScratchSize(size_t n);
+void MultiplyWithScratch(uint64_t *r, uint64_t const *a, uint64_t const *b,
+                         size_t n, uint64_t *scratch);
+void SquareWithScratch(uint64_t *r, uint64_t const *a, size_t n,
+                       uint64_t *scratch);
+
+// The individual multiplication algorithms. Recursive algorithms compute their
+// subproducts with whichever algorithm the thresholds select, so these are
+// primarily useful for testing and benchmarking. The same requirements as
+// `Multiply` apply.
+
+// Sets `r[0, an + bn)` to `a[0, an) * b[0, bn)` in O(an * bn) time.
+void SchoolbookMultiply(uint64_t *r, uint64_t const *a, size_t an,
+                        uint64_t const *b, size_t bn);
+
+// Sets `r[0, 2n)` to `a[0, n) * b[0, n)` using Karatsuba's algorithm. Requires
+// `n >= 2`.
+void KaratsubaMultiply(uint64_t *r, uint64_t const *a, uint64_t const *b,
+                       size_t n);
+
+// Sets `r[0, 2n)` to `a[0, n) * b[0, n)` using Toom-3 with Bodrato's
+// evaluation and interpolation sequence. Requires `n >= 9`.
+void Toom3Multiply(uint64_t *r, uint64_t const *a, uint64_t const *b,
+                   size_t n);
+
+// Squaring counterparts of the algorithms above, with the same requirements as
+// `Square` and the corresponding multiplication.
+void SchoolbookSquare(uint64_t *r, uint64_t const *a, size_t n);
+void KaratsubaSquare(uint64_t *r, uint64_t const *a, size_t n);
+void Toom3Square(uint64_t *r, uint64_t const *a, size_t n);
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_MULTIPLY_H
@@ -0,0 +1,121 @@
+#include "chalk/internal/multiply.h"
+
+#include <random>
+#include <vector>
+
+#include "chalk/integer_thresholds.h"
+#include "chalk/internal/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+std::vector<uint64_t> Schoolbook(std::vector<uint64_t> const &a,
+                                 std::vector<uint64_t> const &b) {
+  std::vector<uint64_t> result(a.size() + b.size());
+  SchoolbookMultiply(result.data(), a.data(), a.size(), b.data(), b.size());
+  return result;
+}
+
+struct Multiplication : testing::Test {
+  void SetUp() override { saved_ = GlobalIntegerThresholds(); }
+  void TearDown() override { GlobalIntegerThresholds() = saved_; }
+
+  std::mt19937_64 gen_{0};
+
+ private:
+  IntegerThresholds saved_;
+};
+
+TEST_F(Multiplication, Karatsuba) {
+  GlobalIntegerThresholds().karatsuba_multiplication = 4;
+  GlobalIntegerThresholds().toom3_multiplication     = 1000;
+  for (size_t n = 2; n < 80; ++n) {
+    auto a = RandomLimbs(n, gen_);
+    auto b = RandomLimbs(n, gen_);
+    std::vector<uint64_t> result(2 * n);
+    KaratsubaMultiply(result.data(), a.data(), b.data(), n);
+    EXPECT_EQ(result, Schoolbook(a, b)) << "n = " << n;
+  }
+}
+
+TEST_F(Multiplication, Toom3) {
+  GlobalIntegerThresholds().karatsuba_multiplication = 4;
+  GlobalIntegerThresholds().toom3_multiplication     = 12;
+  for (size_t n = 9; n < 120; n += 7) {
+    auto a = RandomLimbs(n, gen_);
+    auto b = RandomLimbs(n, gen_);
+    std::vector<uint64_t> result(2 * n);
+    Toom3Multiply(result.data(), a.data(), b.data(), n);
+    EXPECT_EQ(result, Schoolbook(a, b)) << "n = " << n;
+  }
+}
+
+TEST_F(Multiplication, MaximalOperands) {
+  GlobalIntegerThresholds().karatsuba_multiplication = 4;
+  GlobalIntegerThresholds().toom3_multiplication     = 12;
+  for (size_t n : {9, 10, 11, 33, 64}) {
+    std::vector<uint64_t> a(n, ~uint64_t{0});
+    std::vector<uint64_t> result(2 * n);
+    Toom3Multiply(result.data(), a.data(), a.data(), n);
+    EXPECT_EQ(result, Schoolbook(a, a)) << "n = " << n;
+    KaratsubaMultiply(result.data(), a.data(), a.data(), n);
+    EXPECT_EQ(result, Schoolbook(a, a)) << "n = " << n;
+  }
+}
+
+TEST_F(Multiplication, Squaring) {
+  GlobalIntegerThresholds().karatsuba_multiplication = 4;
+  GlobalIntegerThresholds().karatsuba_squaring       = 4;
+  GlobalIntegerThresholds().toom3_multiplication     = 24;
+  GlobalIntegerThresholds().ntt_multiplication       = 100;
+  for (size_t n = 1; n < 130; ++n) {
+    auto a = RandomLimbs(n, gen_);
+    std::vector<uint64_t> expected = Schoolbook(a, a);
+    std::vector<uint64_t> result(2 * n);
+    SchoolbookSquare(result.data(), a.data(), n);
+    EXPECT_EQ(result, expected) << "n = " << n;
+    if (n >= 2) {
+      KaratsubaSquare(result.data(), a.data(), n);
+      EXPECT_EQ(result, expected) << "n = " << n;
+    }
+    if (n >= 9) {
+      Toom3Square(result.data(), a.data(), n);
+      EXPECT_EQ(result, expected) << "n = " << n;
+    }
+    Square(result.data(), a.data(), n);
+    EXPECT_EQ(result, expected) << "n = " << n;
+    Multiply(result.data(), a.data(), n, a.data(), n);
+    EXPECT_EQ(result, expected) << "n = " << n;
+  }
+}
+
+TEST_F(Multiplication, MaximalSquares) {
+  GlobalIntegerThresholds().karatsuba_multiplication = 4;
+  GlobalIntegerThresholds().karatsuba_squaring       = 4;
+  GlobalIntegerThresholds().toom3_multiplication     = 24;
+  for (size_t n : {1, 2, 3, 10, 40}) {
+    std::vector<uint64_t> a(n, ~uint64_t{0});
+    std::vector<uint64_t> result(2 * n);
+    Square(result.data(), a.data(), n);
+    EXPECT_EQ(result, Schoolbook(a, a)) << "n = " << n;
+  }
+}
+
+TEST_F(Multiplication, Unbalanced) {
+  GlobalIntegerThresholds().karatsuba_multiplication = 4;
+  GlobalIntegerThresholds().toom3_multiplication     = 12;
+  for (size_t an : {1, 5, 17, 40, 101}) {
+    for (size_t bn : {1, 3, 4, 13, 40}) {
+      auto a = RandomLimbs(an, gen_);
+      auto b = RandomLimbs(bn, gen_);
+      std::vector<uint64_t> result(an + bn);
+      Multiply(result.data(), a.data(), an, b.data(), bn);
+      EXPECT_EQ(result, Schoolbook(a, b)) << an << " x " << bn;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace chalk::internal_integer
@@ -0,0 +1,331 @@
+#include "chalk/internal/ntt.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <vector>
+
+#include "chalk/integer_executor.h"
+#include "chalk/integer_thresholds.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/montgomery.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+// A prime `p = c * 2^k + 1` with `2^62 < p < 2^63`. Values are in the
+// standard representation unless stated otherwise.
+struct NttPrime : Montgomery64 {
+  constexpr NttPrime(uint64_t modulus, int two_adicity, uint64_t generator)
+      : Montgomery64(modulus),
+        two_adicity(two_adicity),
+        generator(generator) {}
+
+  // Returns the inverse of `a` modulo `p` in Montgomery form.
+  uint64_t Inverse(uint64_t a) const {
+    return Power(ToMontgomery(a), modulus - 2);
+  }
+
+  // Reduces an arbitrary limb modulo `p`. Since `p > 2^62`, at most three
+  // subtractions are needed.
+  uint64_t Reduce(uint64_t a) const {
+    while (a >= modulus) { a -= modulus; }
+    return a;
+  }
+
+  int two_adicity;
+  uint64_t generator;
+};
+
+constexpr std::array<NttPrime, 3> kPrimes = {
+    NttPrime(0x5700000000000001, 56, 5),
+    NttPrime(0x4180000000000001, 55, 3),
+    NttPrime(0x6280000000000001, 55, 3),
+};
+
+// Each coefficient of the convolution is a sum of at most `n` products of two
+// limbs, and so is less than `n * 2^128`. Since each prime exceeds 2^62, their
+// product exceeds 2^186 and can represent any coefficient of a transform no
+// longer than this.
+constexpr int kMaximumLogLength = 55;
+
+// Transforms are split between tasks only if each task is left with at least
+// this many coefficients.
+constexpr size_t kMinimumTaskLength = size_t{1} << 12;
+
+// Returns the number of tasks, a power of two dividing `length`, among which
+// the work of a transform of `length` coefficients is split on `executor`.
+size_t TaskCount(IntegerExecutor const &executor, size_t length) {
+  size_t tasks = std::bit_ceil(executor.concurrency());
+  return std::max<size_t>(1, std::min(tasks, length / kMinimumTaskLength));
+}
+
+// Calls `f(begin, end)` for `tasks` equal consecutive ranges covering
+// `[0, length)`, which `tasks` must divide.
+template <typename F>
+void ForEachRange(IntegerExecutor &executor, size_t tasks, size_t length,
+                  F &&f) {
+  size_t chunk = length / tasks;
+  executor.Run(tasks, [&](size_t t) { f(t * chunk, (t + 1) * chunk); });
+}
+
+// Fills `roots[m + j]` with `w^j` in Montgomery form, where `w` is a primitive
+// `2m`-th root of unity (or its inverse), for each power of two `m < length`.
+// Each task starts its range of powers from `w` raised to its first index.
+std::vector<uint64_t> RootTable(NttPrime const prime, size_t length,
+                                bool inverse, IntegerExecutor &executor,
+                                size_t tasks) {
+  std::vector<uint64_t> roots(length);
+  if (length < 2) { return roots; }
+  uint64_t generator = prime.ToMontgomery(prime.generator);
+  for (size_t m = length / 2; m >= 1; m /= 2) {
+    uint64_t w = prime.Power(generator, (prime.modulus - 1) / (2 * m));
+    if (inverse) { w = prime.Power(w, prime.modulus - 2); }
+    size_t stage_tasks =
+        std::max<size_t>(1, std::min(tasks, m / kMinimumTaskLength));
+    ForEachRange(executor, stage_tasks, m, [&](size_t begin, size_t end) {
+      uint64_t power = prime.Power(w, begin);
+      for (size_t j = begin; j < end; ++j) {
+        roots[m + j] = power;
+        power        = prime.Multiply(power, w);
+      }
+    });
+  }
+  return roots;
+}
+
+// Applies the butterflies `j` in `[begin, end)` of the stage of a forward
+// transform pairing `x[j]` with `x[j + m]`. The prime is taken by value so that
+// its constants stay in registers rather than being reloaded after each store.
+void ForwardButterflies(NttPrime const prime, uint64_t *x, size_t m,
+                        uint64_t const *roots, size_t begin, size_t end) {
+  uint64_t *y = x + m;
+  for (size_t j = begin; j < end; ++j) {
+    uint64_t u = x[j];
+    uint64_t v = y[j];
+    x[j]       = prime.Add(u, v);
+    y[j]       = prime.Multiply(prime.Subtract(u, v), roots[m + j]);
+  }
+}
+
+// As above, for the stage of an inverse transform.
+void InverseButterflies(NttPrime const prime, uint64_t *x, size_t m,
+                        uint64_t const *roots, size_t begin, size_t end) {
+  uint64_t *y = x + m;
+  for (size_t j = begin; j < end; ++j) {
+    uint64_t u = x[j];
+    uint64_t v = prime.Multiply(y[j], roots[m + j]);
+    x[j]       = prime.Add(u, v);
+    y[j]       = prime.Subtract(u, v);
+  }
+}
+
+// Decimation-in-frequency transform taking coefficients in natural order to
+// evaluations in bit-reversed order.
+//
+// The work is split between `tasks` tasks, each owning a contiguous segment of
+// `length / tasks` coefficients. Stages pairing coefficients further apart
+// than a segment split the butterflies of each stage evenly between the tasks,
+// and the remaining stages act on each segment independently, as a transform
+// of the segment's length. Every butterfly computes the same value however
+// the work is split.
+void ForwardTransform(NttPrime const &prime, uint64_t *a, size_t length,
+                      uint64_t const *roots, IntegerExecutor &executor,
+                      size_t tasks) {
+  size_t segment = length / tasks;
+  for (size_t m = length / 2; m >= segment; m /= 2) {
+    ForEachRange(executor, tasks, length / 2, [&](size_t begin, size_t end) {
+      // A task's butterflies lie within a single block of `2m` coefficients.
+      size_t block = begin / m;
+      ForwardButterflies(prime, a + 2 * m * block, m, roots, begin % m,
+                         end - block * m);
+    });
+  }
+  executor.Run(tasks, [&](size_t t) {
+    uint64_t *s = a + t * segment;
+    for (size_t m = segment / 2; m >= 1; m /= 2) {
+      for (size_t start = 0; start < segment; start += 2 * m) {
+        ForwardButterflies(prime, s + start, m, roots, 0, m);
+      }
+    }
+  });
+}
+
+// Decimation-in-time transform taking evaluations in bit-reversed order to
+// `length` times the coefficients in natural order, given the inverse roots.
+// The work is split as for `ForwardTransform`, with the stages in reverse.
+void InverseTransform(NttPrime const &prime, uint64_t *a, size_t length,
+                      uint64_t const *roots, IntegerExecutor &executor,
+                      size_t tasks) {
+  size_t segment = length / tasks;
+  executor.Run(tasks, [&](size_t t) {
+    uint64_t *s = a + t * segment;
+    for (size_t m = 1; m < segment; m *= 2) {
+      for (size_t start = 0; start < segment; start += 2 * m) {
+        InverseButterflies(prime, s + start, m, roots, 0, m);
+      }
+    }
+  });
+  for (size_t m = segment; m < length; m *= 2) {
+    ForEachRange(executor, tasks, length / 2, [&](size_t begin, size_t end) {
+      size_t block = begin / m;
+      InverseButterflies(prime, a + 2 * m * block, m, roots, begin % m,
+                         end - block * m);
+    });
+  }
+}
+
+// Computes the cyclic convolution of `a` and `b` modulo `prime`, writing the
+// residues of the first `length` coefficients to `result`. A null `b` denotes
+// the convolution of `a` with itself, which needs only one forward transform.
+void Convolve(NttPrime const prime, uint64_t const *a, size_t an,
+              uint64_t const *b, size_t bn, size_t length, uint64_t *result,
+              IntegerExecutor &executor) {
+  size_t tasks = TaskCount(executor, length);
+  std::vector<uint64_t> roots =
+      RootTable(prime, length, false, executor, tasks);
+  std::vector<uint64_t> transformed(b == nullptr ? 0 : length);
+  // The operands are reduced and transformed concurrently.
+  executor.Run(b == nullptr ? 1 : 2, [&](size_t i) {
+    uint64_t const *operand = i == 0 ? a : b;
+    size_t n                = i == 0 ? an : bn;
+    uint64_t *values        = i == 0 ? result : transformed.data();
+    ForEachRange(executor, tasks, length, [&](size_t begin, size_t end) {
+      for (size_t j = begin; j < end; ++j) {
+        values[j] = j < n ? prime.Reduce(operand[j]) : 0;
+      }
+    });
+    ForwardTransform(prime, values, length, roots.data(), executor, tasks);
+  });
+
+  // Each pointwise product carries a spurious factor of `1/R`, and the inverse
+  // transform a spurious factor of `length`. Both are removed by a final
+  // multiplication by `R^2 / length`, whose Montgomery product with the
+  // coefficient divides by one further factor of `R`.
+  uint64_t const *other = b == nullptr ? result : transformed.data();
+  ForEachRange(executor, tasks, length, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      result[i] = prime.Multiply(result[i], other[i]);
+    }
+  });
+  roots = RootTable(prime, length, true, executor, tasks);
+  InverseTransform(prime, result, length, roots.data(), executor, tasks);
+
+  uint64_t inverse_length = prime.modulus - (prime.modulus - 1) / length;
+  uint64_t scale = prime.ToMontgomery(prime.ToMontgomery(inverse_length));
+  ForEachRange(executor, tasks, length, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      result[i] = prime.Multiply(result[i], scale);
+    }
+  });
+}
+
+// Constants for Garner's algorithm, which recovers `x` from its residues
+// `x1`, `x2`, `x3` modulo `p1`, `p2`, `p3` as
+//   `x = v1 + v2 * p1 + v3 * p1 * p2`
+// where each `v` is computed modulo the corresponding prime.
+struct GarnerConstants {
+  GarnerConstants() {
+    auto const &[p1, p2, p3] = kPrimes;
+    inverse_p1_mod_p2        = p2.Inverse(p2.Reduce(p1.modulus));
+    p1_mod_p3                = p3.ToMontgomery(p3.Reduce(p1.modulus));
+    uint64_t p1_p2_mod_p3 =
+        p3.Multiply(p3.Reduce(p1.modulus), p3.ToMontgomery(p3.Reduce(p2.modulus)));
+    inverse_p1_p2_mod_p3 = p3.Inverse(p1_p2_mod_p3);
+    auto [low, high]     = MultiplyLimbs(p1.modulus, p2.modulus);
+    p1_p2                = {low, high};
+  }
+
+  // All in Montgomery form with respect to the indicated prime.
+  uint64_t inverse_p1_mod_p2;
+  uint64_t p1_mod_p3;
+  uint64_t inverse_p1_p2_mod_p3;
+
+  std::array<uint64_t, 2> p1_p2;
+};
+
+GarnerConstants const &Garner() {
+  static GarnerConstants const constants;
+  return constants;
+}
+
+// Sets `r[0, an + bn)` to `a[0, an) * b[0, bn)`, or to the square of `a[0, an)`
+// if `b` is null, in which case `bn` must equal `an`. The convolutions modulo
+// each prime are independent, and run concurrently on `executor`.
+void ConvolutionProduct(uint64_t *r, uint64_t const *a, size_t an,
+                        uint64_t const *b, size_t bn,
+                        IntegerExecutor &executor) {
+  size_t coefficients = an + bn - 1;
+  size_t length       = std::bit_ceil(coefficients);
+  assert(std::countr_zero(length) <= kMaximumLogLength);
+
+  std::array<std::vector<uint64_t>, 3> residues;
+  executor.Run(kPrimes.size(), [&](size_t i) {
+    residues[i].resize(length);
+    Convolve(kPrimes[i], a, an, b, bn, length, residues[i].data(), executor);
+  });
+
+  auto const &[p1, p2, p3]     = kPrimes;
+  GarnerConstants const &garner = Garner();
+
+  // Each coefficient is recovered independently, overwriting its residues
+  // with its three limbs. Each coefficient is less than 2^189, so three limbs
+  // suffice.
+  size_t tasks = TaskCount(executor, length);
+  ForEachRange(executor, tasks, length, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < std::min(end, coefficients); ++i) {
+      uint64_t v1 = residues[0][i];
+      uint64_t v2 = p2.Multiply(p2.Subtract(residues[1][i], p2.Reduce(v1)),
+                                garner.inverse_p1_mod_p2);
+      uint64_t v3 = p3.Subtract(residues[2][i], p3.Reduce(v1));
+      v3 = p3.Subtract(v3, p3.Multiply(p3.Reduce(v2), garner.p1_mod_p3));
+      v3 = p3.Multiply(v3, garner.inverse_p1_p2_mod_p3);
+
+      std::array<uint64_t, 3> coefficient = {v1, 0, 0};
+      auto [low, high]                    = MultiplyLimbs(v2, p1.modulus);
+      uint64_t addend[2]                  = {low, high};
+      Add(coefficient.data(), coefficient.data(), 3, addend, 2);
+      uint64_t product[3];
+      product[2] = MulOne(product, garner.p1_p2.data(), 2, v3);
+      Add(coefficient.data(), coefficient.data(), 3, product, 3);
+      for (size_t j = 0; j < 3; ++j) { residues[j][i] = coefficient[j]; }
+    }
+  });
+
+  // `carry` holds the portion of the sum of the coefficients not yet written,
+  // shifted down to the current limb.
+  std::array<uint64_t, 3> carry = {0, 0, 0};
+  for (size_t i = 0; i < coefficients; ++i) {
+    std::array<uint64_t, 3> coefficient = {residues[0][i], residues[1][i],
+                                           residues[2][i]};
+    AddN(carry.data(), carry.data(), coefficient.data(), 3);
+    r[i]     = carry[0];
+    carry[0] = carry[1];
+    carry[1] = carry[2];
+    carry[2] = 0;
+  }
+  r[coefficients] = carry[0];
+  assert(carry[1] == 0);
+}
+
+// Returns the executor on which to run a product whose smaller operand has `n`
+// limbs.
+IntegerExecutor &ExecutorFor(size_t n) {
+  return n >= GlobalIntegerThresholds().parallel_multiplication
+             ? CurrentIntegerExecutor()
+             : SerialIntegerExecutor();
+}
+
+}  // namespace
+
+void NttMultiply(uint64_t *r, uint64_t const *a, size_t an, uint64_t const *b,
+                 size_t bn) {
+  ConvolutionProduct(r, a, an, b, bn, ExecutorFor(std::min(an, bn)));
+}
+
+void NttSquare(uint64_t *r, uint64_t const *a, size_t n) {
+  ConvolutionProduct(r, a, n, nullptr, n, ExecutorFor(n));
+}
+
+}  // namespace chalk::internal_integer
@@ -0,0 +1,27 @@
+#ifndef CHALK_INTERNAL_NTT_H
+#define CHALK_INTERNAL_NTT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chalk::internal_integer {
+
+// Sets `r[0, an + bn)` to `a[0, an) * b[0, bn)` by computing the convolution of
+// the limbs with number-theoretic transforms modulo three primes between 2^62
+// and 2^63, and recovering each coefficient exactly via the Chinese remainder
+// theorem. Runs in O(n log n) time for operands of `n` limbs. Requires `an` and
+// `bn` to be positive and `r` not to overlap either operand. Products of at
+// least `GlobalIntegerThresholds().parallel_multiplication` limbs spread the
+// convolutions modulo each prime, and the butterflies of each transform, across
+// `CurrentIntegerExecutor()`.
+void NttMultiply(uint64_t *r, uint64_t const *a, size_t an, uint64_t const *b,
+                 size_t bn);
+
+// Sets `r[0, 2n)` to the square of `a[0, n)` as above, but transforming `a`
+// only once for each prime. Requires `n` to be positive and `r` not to overlap
+// `a`.
+void NttSquare(uint64_t *r, uint64_t const *a, size_t n);
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_NTT_H
@@ -0,0 +1,58 @@
+#include "chalk/internal/ntt.h"
+
+#include <random>
+#include <vector>
+
+#include "chalk/internal/multiply.h"
+#include "chalk/internal/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+std::vector<uint64_t> Schoolbook(std::vector<uint64_t> const &a,
+                                 std::vector<uint64_t> const &b) {
+  std::vector<uint64_t> result(a.size() + b.size());
+  SchoolbookMultiply(result.data(), a.data(), a.size(), b.data(), b.size());
+  return result;
+}
+
+std::vector<uint64_t> Ntt(std::vector<uint64_t> const &a,
+                          std::vector<uint64_t> const &b) {
+  std::vector<uint64_t> result(a.size() + b.size());
+  NttMultiply(result.data(), a.data(), a.size(), b.data(), b.size());
+  return result;
+}
+
+TEST(NttMultiply, MatchesSchoolbook) {
+  std::mt19937_64 gen(0);
+  for (size_t an : {1, 2, 3, 17, 64, 300}) {
+    for (size_t bn : {1, 4, 63, 65, 257}) {
+      auto a = RandomLimbs(an, gen);
+      auto b = RandomLimbs(bn, gen);
+      EXPECT_EQ(Ntt(a, b), Schoolbook(a, b)) << an << " x " << bn;
+    }
+  }
+}
+
+TEST(NttMultiply, MaximalOperands) {
+  // Every coefficient of the convolution is as large as possible.
+  for (size_t n : {1, 2, 100, 1024}) {
+    std::vector<uint64_t> a(n, ~uint64_t{0});
+    EXPECT_EQ(Ntt(a, a), Schoolbook(a, a)) << "n = " << n;
+  }
+}
+
+TEST(NttSquare, MatchesSchoolbook) {
+  std::mt19937_64 gen(1);
+  for (size_t n : {1, 2, 3, 64, 65, 300, 1024}) {
+    auto a = RandomLimbs(n, gen);
+    std::vector<uint64_t> result(2 * n);
+    NttSquare(result.data(), a.data(), n);
+    EXPECT_EQ(result, Schoolbook(a, a)) << "n = " << n;
+  }
+}
+
+}  // namespace
+}  // namespace chalk::internal_integer
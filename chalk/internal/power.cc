@@ -0,0 +1,184 @@
+#include "chalk/internal/power.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "chalk/internal/divide.h"
+#include "chalk/internal/limb_vector.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/multiply.h"
+#include "chalk/internal/sliding_window.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+// Returns `a^e` for a normalized non-zero `a`.
+Limbs Power(Limbs const &a, uint64_t e) {
+  Limbs result(PowSize(a.data(), a.size(), e));
+  Pow(result.data(), a.data(), a.size(), e);
+  Normalize(result);
+  return result;
+}
+
+// Returns an upper bound on the `k`-th root of `a`, which must be less than
+// `2^64`, from a floating-point estimate of its logarithm. The estimate is
+// accurate to far better than the relative margin added to it.
+uint64_t SingleLimbEstimate(Limbs const &a, uint64_t k) {
+  size_t n       = a.size();
+  double leading = static_cast<double>(a[n - 1]);
+  if (n > 1) { leading = std::ldexp(leading, 64) + a[n - 2]; }
+  double log  = std::log2(leading) + 64.0 * (n - std::min<size_t>(n, 2));
+  double root = std::exp2(log / k) * (1 + 0x1p-30) + 2;
+  if (root >= 0x1p64) { return std::numeric_limits<uint64_t>::max(); }
+  return static_cast<uint64_t>(root);
+}
+
+// Returns `((k - 1) * x + a / x^(k - 1)) / k`, rounded down, which is no less
+// than the `k`-th root of `a` and, if `x` exceeds that root, is less than `x`.
+Limbs NewtonStep(Limbs const &a, Limbs const &x, uint64_t k) {
+  Limbs power = k == 2 ? x : Power(x, k - 1);
+  Limbs quotient;
+  if (Compare(power, a) <= 0) {
+    quotient.resize(a.size() - power.size() + 1);
+    Limbs remainder(power.size());
+    DivRem(quotient.data(), remainder.data(), a.data(), a.size(), power.data(),
+           power.size());
+    Normalize(quotient);
+  }
+
+  Limbs result(std::max(x.size(), quotient.size()) + 2);
+  result[x.size()] = MulOne(result.data(), x.data(), x.size(), k - 1);
+  Add(result.data(), result.data(), result.size(), quotient.data(),
+      quotient.size());
+  DivRemOne(result.data(), result.data(), result.size(), k);
+  Normalize(result);
+  return result;
+}
+
+// Returns the `k`-th root of a normalized non-zero `a`, for `k >= 2`.
+Limbs RootOf(Limbs const &a, uint64_t k) {
+  size_t size = RootSize(a.size(), k);
+  Limbs x;
+  if (size == 1) {
+    x = {SingleLimbEstimate(a, k)};
+  } else {
+    // If `r` is the root of `a / 2^(64 * k * t)`, then `(r + 1) * 2^(64 * t)`
+    // exceeds the root of `a`, with a relative error of about `1 / r`.
+    size_t t = size / 2;
+    Limbs r  = RootOf(Limbs(a.begin() + k * t, a.end()), k);
+    r.push_back(0);
+    AddOne(r.data(), r.data(), r.size(), 1);
+    Normalize(r);
+    x.assign(t, 0);
+    x.insert(x.end(), r.begin(), r.end());
+  }
+
+  // From any upper bound, Newton's iteration stays an upper bound and strictly
+  // decreases until it reaches the root. As the estimate is already accurate
+  // to about half its length, a single step usually lands on the root, and a
+  // power, far cheaper than the division a further step would cost, confirms
+  // it.
+  while (true) {
+    x           = NewtonStep(a, x, k);
+    Limbs power = Power(x, k);
+    if (Compare(power, a) <= 0) { return x; }
+  }
+}
+
+}  // namespace
+
+size_t PowSize(uint64_t const *a, size_t an, uint64_t e) {
+  an = Normalized(a, an);
+  if (an == 0 or e == 0) { return 1; }
+  // Powers of one stay small however large the exponent.
+  if (an == 1 and a[0] == 1) { return 1; }
+  size_t bits = 64 * (an - 1) + std::bit_width(a[an - 1]);
+  assert(bits <= std::numeric_limits<size_t>::max() / e);
+  return (bits * e + 63) / 64;
+}
+
+void Pow(uint64_t *r, uint64_t const *a, size_t an, uint64_t e) {
+  size_t size = PowSize(a, an, e);
+  std::fill(r, r + size, 0);
+  an = Normalized(a, an);
+  if (e == 0) {
+    r[0] = 1;
+    return;
+  }
+  if (an == 0) { return; }
+
+  // Each trailing zero limb of `a` contributes `e` zero limbs to the result.
+  size_t zeros = 0;
+  while (a[zeros] == 0) { ++zeros; }
+  a += zeros;
+  an -= zeros;
+  r += zeros * e;
+  size -= zeros * e;
+
+  // The table holds `a^1, a^3, ..., a^(2^k - 1)`, built from `a^2`.
+  int k = WindowBits(std::bit_width(e));
+  std::vector<Limbs> table(size_t{1} << (k - 1));
+  table[0].assign(a, a + an);
+  if (k > 1) {
+    Limbs square(2 * an);
+    Square(square.data(), a, an);
+    Normalize(square);
+    for (size_t i = 1; i < table.size(); ++i) {
+      Limbs const &previous = table[i - 1];
+      table[i].resize(previous.size() + square.size());
+      Multiply(table[i].data(), previous.data(), previous.size(),
+               square.data(), square.size());
+      Normalize(table[i]);
+    }
+  }
+
+  // Every partial power divides the result, so the two buffers need room only
+  // for the result and the one limb by which a product's length may exceed
+  // that of its value.
+  Limbs value(size + 1), scratch(size + 1);
+  size_t value_size = 0;
+
+  auto square = [&] {
+    Square(scratch.data(), value.data(), value_size);
+    value_size = Normalized(scratch.data(), 2 * value_size);
+    std::swap(value, scratch);
+  };
+  auto multiply = [&](size_t i) {
+    Limbs const &factor = table[i];
+    Multiply(scratch.data(), value.data(), value_size, factor.data(),
+             factor.size());
+    value_size = Normalized(scratch.data(), value_size + factor.size());
+    std::swap(value, scratch);
+  };
+  auto start = [&](size_t i) {
+    std::copy(table[i].begin(), table[i].end(), value.begin());
+    value_size = table[i].size();
+  };
+  SlidingWindow(&e, 1, k, start, square, multiply);
+  std::copy(value.begin(), value.begin() + value_size, r);
+}
+
+void Root(uint64_t *r, uint64_t const *a, size_t an, uint64_t k) {
+  assert(an > 0 and k > 0);
+  size_t size = RootSize(an, k);
+  std::fill(r, r + size, 0);
+  an = Normalized(a, an);
+  if (an == 0) { return; }
+  if (k == 1) {
+    std::copy(a, a + an, r);
+    return;
+  }
+  // Values of fewer than `k` bits have a root of one.
+  if (k >= 64 * (an - 1) + std::bit_width(a[an - 1])) {
+    r[0] = 1;
+    return;
+  }
+  Limbs root = RootOf(Limbs(a, a + an), k);
+  std::copy(root.begin(), root.end(), r);
+}
+
+}  // namespace chalk::internal_integer
@@ -0,0 +1,33 @@
+#ifndef CHALK_INTERNAL_POWER_H
+#define CHALK_INTERNAL_POWER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chalk::internal_integer {
+
+// Returns the number of limbs `Pow` writes for `a[0, an)^e`, which is enough to
+// hold any value of `e` times as many bits as `a`, or one if `a` is one.
+size_t PowSize(uint64_t const *a, size_t an, uint64_t e);
+
+// Sets `r[0, PowSize(a, an, e))` to `a[0, an)^e`, where `0^0` is one, by
+// left-to-right sliding-window exponentiation. Squarings use the dedicated
+// squaring kernels, and each window costs one multiplication by a precomputed
+// odd power of `a`. Requires `r` not to overlap `a`.
+void Pow(uint64_t *r, uint64_t const *a, size_t an, uint64_t e);
+
+// Returns the number of limbs `Root` writes for a value of `an` limbs.
+inline size_t RootSize(size_t an, uint64_t k) {
+  return an / k + (an % k != 0);
+}
+
+// Sets `r[0, RootSize(an, k))` to the largest integer whose `k`-th power is at
+// most `a[0, an)`, by Newton's iteration. The initial estimate is the root of
+// the leading limbs of `a`, computed recursively and scaled, so that only a
+// couple of iterations run at each precision. Requires `an` and `k` to be
+// positive.
+void Root(uint64_t *r, uint64_t const *a, size_t an, uint64_t k);
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_POWER_H
@@ -0,0 +1,154 @@
+#include "chalk/internal/power.h"
+
+#include <random>
+#include <vector>
+
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/multiply.h"
+#include "chalk/internal/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+using Limbs = std::vector<uint64_t>;
+
+Limbs Normalize(Limbs a) {
+  a.resize(Normalized(a.data(), a.size()));
+  return a;
+}
+
+Limbs Product(Limbs const &a, Limbs const &b) {
+  if (a.empty() or b.empty()) { return {}; }
+  Limbs result(a.size() + b.size());
+  Multiply(result.data(), a.data(), a.size(), b.data(), b.size());
+  return Normalize(result);
+}
+
+Limbs ReferencePow(Limbs const &a, uint64_t e) {
+  Limbs result = {1};
+  for (uint64_t i = 0; i < e; ++i) { result = Product(result, Normalize(a)); }
+  return result;
+}
+
+Limbs Power(Limbs const &a, uint64_t e) {
+  Limbs result(PowSize(a.data(), a.size(), e));
+  Pow(result.data(), a.data(), a.size(), e);
+  return Normalize(result);
+}
+
+Limbs RootOf(Limbs const &a, uint64_t k) {
+  Limbs result(RootSize(a.size(), k));
+  Root(result.data(), a.data(), a.size(), k);
+  return Normalize(result);
+}
+
+// Checks that `r^k <= a < (r + 1)^k` for `r` the computed root of `a`.
+void ExpectValidRoot(Limbs const &a, uint64_t k) {
+  Limbs r    = RootOf(a, k);
+  Limbs next = r;
+  next.push_back(0);
+  AddOne(next.data(), next.data(), next.size(), 1);
+  Limbs normalized = Normalize(a);
+  Limbs lower      = Power(r, k);
+  Limbs upper      = Power(Normalize(next), k);
+  EXPECT_LE(Compare(lower.data(), lower.size(), normalized.data(),
+                    normalized.size()),
+            0)
+      << "size = " << a.size() << ", k = " << k;
+  EXPECT_GT(Compare(upper.data(), upper.size(), normalized.data(),
+                    normalized.size()),
+            0)
+      << "size = " << a.size() << ", k = " << k;
+}
+
+TEST(Pow, Small) {
+  EXPECT_EQ(Power(Limbs{0}, 0), Limbs{1});
+  EXPECT_EQ(Power(Limbs{0}, 5), Limbs{});
+  EXPECT_EQ(Power(Limbs{7}, 0), Limbs{1});
+  EXPECT_EQ(Power(Limbs{3}, 40), Limbs{12157665459056928801u});
+  EXPECT_EQ(Power(Limbs{2}, 64), (Limbs{0, 1}));
+  EXPECT_EQ(Power(Limbs{1}, ~uint64_t{0}), Limbs{1});
+}
+
+TEST(Pow, MatchesRepeatedMultiplication) {
+  // Exponents of these lengths exercise every window size, and bases with
+  // trailing zero limbs the shortcut for them.
+  std::mt19937_64 gen(0);
+  for (size_t n : {1, 2, 5, 20}) {
+    for (uint64_t e : {1, 2, 3, 7, 16, 255, 300, 1001}) {
+      Limbs a = RandomNormalizedLimbs(n, gen);
+      EXPECT_EQ(Power(a, e), ReferencePow(a, e))
+          << "n = " << n << ", e = " << e;
+      a.insert(a.begin(), 0);
+      EXPECT_EQ(Power(a, e), ReferencePow(a, e))
+          << "n = " << n << ", e = " << e;
+    }
+  }
+}
+
+TEST(Pow, FullExponent) {
+  // `(2^64 - 1)^e` has exactly `PowSize` limbs, so a short product would show.
+  uint64_t e = 0x10001;
+  Limbs a    = {~uint64_t{0}};
+  EXPECT_EQ(PowSize(a.data(), a.size(), e), e);
+  Limbs result = Power(a, e);
+  EXPECT_EQ(result.size(), e);
+  // `(-1)^e = -1` modulo `2^64`, and the result is odd.
+  EXPECT_EQ(result[0], ~uint64_t{0});
+}
+
+TEST(Root, Small) {
+  EXPECT_EQ(RootOf(Limbs{0}, 2), Limbs{});
+  EXPECT_EQ(RootOf(Limbs{1}, 2), Limbs{1});
+  EXPECT_EQ(RootOf(Limbs{15}, 2), Limbs{3});
+  EXPECT_EQ(RootOf(Limbs{16}, 2), Limbs{4});
+  EXPECT_EQ(RootOf(Limbs{26}, 3), Limbs{2});
+  EXPECT_EQ(RootOf(Limbs{27}, 3), Limbs{3});
+  EXPECT_EQ(RootOf(Limbs{12345}, 1), Limbs{12345});
+  EXPECT_EQ(RootOf(Limbs{~uint64_t{0}}, 2), Limbs{0xffffffff});
+  EXPECT_EQ(RootOf(Limbs{0, 1}, 2), Limbs{uint64_t{1} << 32});
+  EXPECT_EQ(RootOf(Limbs{~uint64_t{0}}, 64), Limbs{1});
+  EXPECT_EQ(RootOf(Limbs{0, 1}, 64), Limbs{2});
+  EXPECT_EQ(RootOf(Limbs{0, 0, 0}, 1000000), Limbs{});
+}
+
+TEST(Root, Random) {
+  std::mt19937_64 gen(0);
+  for (size_t n : {1, 2, 3, 4, 7, 16, 33, 100}) {
+    for (uint64_t k : {2, 3, 4, 5, 7, 64, 65, 200}) {
+      for (int trial = 0; trial < 3; ++trial) {
+        ExpectValidRoot(RandomNormalizedLimbs(n, gen), k);
+      }
+    }
+  }
+}
+
+TEST(Root, ExactPowers) {
+  // Perfect powers and their neighbours are where an off-by-one would show.
+  std::mt19937_64 gen(0);
+  for (size_t n : {1, 2, 6, 25}) {
+    for (uint64_t k : {2, 3, 5}) {
+      Limbs r     = RandomNormalizedLimbs(n, gen);
+      Limbs power = Power(r, k);
+      EXPECT_EQ(RootOf(power, k), Normalize(r));
+      ExpectValidRoot(power, k);
+      SubOne(power.data(), power.data(), power.size(), 1);
+      ExpectValidRoot(power, k);
+      power.push_back(0);
+      AddOne(power.data(), power.data(), power.size(), 2);
+      ExpectValidRoot(power, k);
+    }
+  }
+}
+
+TEST(Root, AllOnes) {
+  for (size_t n : {1, 2, 3, 10, 51}) {
+    Limbs ones(n, ~uint64_t{0});
+    for (uint64_t k : {2, 3, 13}) { ExpectValidRoot(ones, k); }
+  }
+}
+
+}  // namespace
+}  // namespace chalk::internal_integer
@@ -0,0 +1,233 @@
+#include "chalk/internal/radix.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <charconv>
+#include <mutex>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "chalk/integer_thresholds.h"
+#include "chalk/internal/divide.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/multiply.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+// The largest power of ten fitting in a limb, and its number of zeros.
+constexpr uint64_t kChunk    = 10'000'000'000'000'000'000u;
+constexpr size_t kChunkDigits = 19;
+
+// Writes exactly `kChunkDigits` digits of `chunk`, including leading zeros.
+void WriteChunk(char *out, uint64_t chunk) {
+  for (size_t i = kChunkDigits; i-- > 0;) {
+    out[i] = static_cast<char>('0' + chunk % 10);
+    chunk /= 10;
+  }
+}
+
+// Writes the decimal digits of `a[0, n)` to `out`, destroying `a`. If `width`
+// is zero, leading zeros are omitted (so that nothing is written for a zero
+// value). Otherwise exactly `width` digits are written, which requires the
+// value to be less than `10^width` and `width` to be a multiple of
+// `kChunkDigits`.
+char *SchoolbookToDecimal(char *out, uint64_t *a, size_t n, size_t width) {
+  static LimbDivisor const divisor(kChunk);
+  std::vector<uint64_t> chunks;
+  for (n = Normalized(a, n); n > 0; n = Normalized(a, n)) {
+    chunks.push_back(DivRemOne(a, a, n, divisor));
+  }
+  if (width == 0) {
+    if (chunks.empty()) { return out; }
+    out = std::to_chars(out, out + kChunkDigits, chunks.back()).ptr;
+    chunks.pop_back();
+  } else {
+    size_t zeros = width - kChunkDigits * chunks.size();
+    out          = std::fill_n(out, zeros, '0');
+  }
+  for (auto iter = chunks.rbegin(); iter != chunks.rend(); ++iter) {
+    WriteChunk(out, *iter);
+    out += kChunkDigits;
+  }
+  return out;
+}
+
+// As `SchoolbookToDecimal`, but splits values of at least `threshold` limbs
+// into a quotient and remainder by the largest of `powers` having at most
+// half as many limbs, where `powers[k]` is `10^(kChunkDigits * 2^k)`, and
+// converts each recursively.
+char *RecursiveToDecimal(char *out, uint64_t *a, size_t n, size_t width,
+                         absl::Span<std::vector<uint64_t> const> powers,
+                         size_t threshold) {
+  n = Normalized(a, n);
+  if (n < threshold) { return SchoolbookToDecimal(out, a, n, width); }
+
+  size_t k = powers.size() - 1;
+  while (k > 0 and 2 * powers[k].size() > n + 1) { --k; }
+  std::vector<uint64_t> const &power = powers[k];
+  size_t low_width                   = kChunkDigits << k;
+
+  std::vector<uint64_t> q(n - power.size() + 1), r(power.size());
+  DivRem(q.data(), r.data(), a, n, power.data(), power.size());
+  if (width == 0 and Normalized(q.data(), q.size()) == 0) {
+    return RecursiveToDecimal(out, r.data(), r.size(), 0, powers, threshold);
+  }
+  out = RecursiveToDecimal(out, q.data(), q.size(),
+                           width == 0 ? 0 : width - low_width, powers,
+                           threshold);
+  return RecursiveToDecimal(out, r.data(), r.size(), low_width, powers,
+                            threshold);
+}
+
+// The powers `10^(kChunkDigits * 2^k)` used by conversions in both
+// directions, each computed by squaring the last the first time a conversion
+// needs it, and kept for the lifetime of the program. They are held in
+// `std::vector`s rather than `Integer`s, so are unaffected by the current
+// `LimbAllocator`. The power for `k` has at most `2^k` limbs, since `10^19`
+// fits in a limb, and more than `2^(k - 1)`.
+struct PowerTable {
+  // Returns the first `count` powers. Once computed, a power never changes, so
+  // the returned powers may be read without synchronization.
+  absl::Span<std::vector<uint64_t> const> Powers(size_t count) {
+    assert(count <= powers_.size());
+    std::lock_guard lock(mutex_);
+    if (size_ == 0) { powers_[size_++] = {kChunk}; }
+    for (; size_ < count; ++size_) {
+      std::vector<uint64_t> const &last = powers_[size_ - 1];
+      std::vector<uint64_t> square(2 * last.size());
+      Multiply(square.data(), last.data(), last.size(), last.data(),
+               last.size());
+      square.resize(Normalized(square.data(), square.size()));
+      powers_[size_] = std::move(square);
+    }
+    return absl::MakeConstSpan(powers_.data(), count);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::array<std::vector<uint64_t>, 64> powers_;
+  size_t size_ = 0;
+};
+
+absl::Span<std::vector<uint64_t> const> PowersOfChunk(size_t count) {
+  static PowerTable table;
+  return table.Powers(count);
+}
+
+// Sets `r[0, m)` to the value of `chunks[0, m)`, which are the digits of a
+// number in base `kChunk` with the least significant first. If `m` is at least
+// `threshold`, the high and low chunks are converted separately, splitting at
+// the largest power of two below `m`, and combined as
+// `high * powers[k] + low`.
+void ChunksToLimbs(uint64_t *r, uint64_t const *chunks, size_t m,
+                   absl::Span<std::vector<uint64_t> const> powers,
+                   size_t threshold) {
+  if (m < threshold) {
+    for (size_t i = m; i-- > 0;) {
+      size_t used   = m - 1 - i;
+      uint64_t high = MulOne(r, r, used, kChunk);
+      r[used]       = high + AddOne(r, r, used, chunks[i]);
+    }
+    return;
+  }
+
+  size_t low_size                    = std::bit_floor(m - 1);
+  std::vector<uint64_t> const &power = powers[std::countr_zero(low_size)];
+  std::vector<uint64_t> low(low_size), high(m - low_size);
+  ChunksToLimbs(low.data(), chunks, low_size, powers, threshold);
+  ChunksToLimbs(high.data(), chunks + low_size, high.size(), powers, threshold);
+
+  // `power` has at most `low_size` limbs, since each chunk fits in a limb.
+  Multiply(r, high.data(), high.size(), power.data(), power.size());
+  std::fill(r + high.size() + power.size(), r + m, 0);
+  [[maybe_unused]] uint64_t carry = Add(r, r, m, low.data(), low_size);
+  assert(carry == 0);
+}
+
+int HexadecimalDigit(char c) {
+  if (c <= '9') { return c - '0'; }
+  return (c | 0x20) - 'a' + 10;
+}
+
+}  // namespace
+
+size_t DecimalDigitsBound(size_t n) {
+  // 1234 / 4096 slightly exceeds log10(2).
+  return 64 * n * 1234 / 4096 + 1;
+}
+
+char *ToDecimal(char *out, uint64_t const *a, size_t n) {
+  n = Normalized(a, n);
+  if (n == 0) {
+    *out = '0';
+    return out + 1;
+  }
+
+  size_t threshold =
+      std::max<size_t>(GlobalIntegerThresholds().radix_conversion, 2);
+  // The recursion splits by powers of at most `(n + 1) / 2` limbs, all of which
+  // are among those with `2^(k - 1) < (n + 1) / 2`.
+  absl::Span<std::vector<uint64_t> const> powers;
+  if (n >= threshold) { powers = PowersOfChunk(std::bit_width(n)); }
+  std::vector<uint64_t> scratch(a, a + n);
+  return RecursiveToDecimal(out, scratch.data(), n, 0, powers, threshold);
+}
+
+char *ToHexadecimal(char *out, uint64_t const *a, size_t n) {
+  n   = std::max<size_t>(Normalized(a, n), 1);
+  out = std::to_chars(out, out + 16, a[n - 1], 16).ptr;
+  for (size_t i = n - 1; i-- > 0;) {
+    uint64_t limb = a[i];
+    for (size_t j = 16; j-- > 0;) {
+      out[j] = "0123456789abcdef"[limb & 0xf];
+      limb >>= 4;
+    }
+    out += 16;
+  }
+  return out;
+}
+
+size_t DecimalLimbs(size_t n) {
+  return (n + kChunkDigits - 1) / kChunkDigits;
+}
+
+void FromDecimal(uint64_t *r, char const *digits, size_t n) {
+  size_t m = DecimalLimbs(n);
+  std::vector<uint64_t> chunks(m);
+  for (size_t i = 0; i < m; ++i) {
+    char const *end   = digits + n - i * kChunkDigits;
+    char const *begin = i + 1 == m ? digits : end - kChunkDigits;
+    uint64_t chunk    = 0;
+    for (char const *p = begin; p != end; ++p) {
+      chunk = 10 * chunk + (*p - '0');
+    }
+    chunks[i] = chunk;
+  }
+
+  size_t threshold =
+      std::max<size_t>(GlobalIntegerThresholds().radix_conversion, 2);
+  // The recursion splits by the powers for each `k` with `2^k < m`.
+  absl::Span<std::vector<uint64_t> const> powers;
+  if (m >= threshold) { powers = PowersOfChunk(std::bit_width(m - 1)); }
+  ChunksToLimbs(r, chunks.data(), m, powers, threshold);
+}
+
+size_t HexadecimalLimbs(size_t n) { return (n + 15) / 16; }
+
+void FromHexadecimal(uint64_t *r, char const *digits, size_t n) {
+  size_t m = HexadecimalLimbs(n);
+  for (size_t i = 0; i < m; ++i) {
+    char const *end   = digits + n - 16 * i;
+    char const *begin = i + 1 == m ? digits : end - 16;
+    uint64_t limb     = 0;
+    for (char const *p = begin; p != end; ++p) {
+      limb = (limb << 4) | HexadecimalDigit(*p);
+    }
+    r[i] = limb;
+  }
+}
+
+}  // namespace chalk::internal_integer
@@ -0,0 +1,44 @@
+#ifndef CHALK_INTERNAL_RADIX_H
+#define CHALK_INTERNAL_RADIX_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chalk::internal_integer {
+
+// Returns an upper bound on the number of decimal digits needed to write a
+// value of `n` limbs.
+size_t DecimalDigitsBound(size_t n);
+
+// Writes the decimal digits of `a[0, n)`, without leading zeros, to `out` and
+// returns a pointer past the last digit written. A zero value is written as
+// "0". Requires `n >= 1` and `out` to have room for `DecimalDigitsBound(n)`
+// characters. Large values are converted by dividing by powers of 10^19
+// recursively, in time proportional to that of division. The powers are
+// computed once and shared with `FromDecimal`.
+char *ToDecimal(char *out, uint64_t const *a, size_t n);
+
+// As above, but writes lowercase hexadecimal digits. Requires `out` to have
+// room for `16 * n` characters.
+char *ToHexadecimal(char *out, uint64_t const *a, size_t n);
+
+// Returns the number of limbs `FromDecimal` writes for `n` digits.
+size_t DecimalLimbs(size_t n);
+
+// Sets `r[0, DecimalLimbs(n))` to the value of the decimal digits
+// `digits[0, n)`, which must each be one of '0' through '9'. Requires `n >= 1`.
+// Digits are grouped into chunks of 19, each of which fits in a limb, and large
+// inputs combine the chunks with a product tree of powers of 10^19 in time
+// proportional to that of multiplication.
+void FromDecimal(uint64_t *r, char const *digits, size_t n);
+
+// Returns the number of limbs `FromHexadecimal` writes for `n` digits.
+size_t HexadecimalLimbs(size_t n);
+
+// Sets `r[0, HexadecimalLimbs(n))` to the value of the hexadecimal digits
+// `digits[0, n)`, which may be of either case. Requires `n >= 1`.
+void FromHexadecimal(uint64_t *r, char const *digits, size_t n);
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_RADIX_H
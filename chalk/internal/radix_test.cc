@@ -0,0 +1,123 @@
+#include "chalk/internal/radix.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chalk/integer_thresholds.h"
+#include "chalk/internal/limbs.h"
+#include "chalk/internal/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk::internal_integer {
+namespace {
+
+std::string Decimal(std::vector<uint64_t> const &a) {
+  std::string result(DecimalDigitsBound(a.size()), '\0');
+  result.resize(ToDecimal(result.data(), a.data(), a.size()) - result.data());
+  return result;
+}
+
+struct RadixConversion : testing::Test {
+  void SetUp() override { saved_ = GlobalIntegerThresholds(); }
+  void TearDown() override { GlobalIntegerThresholds() = saved_; }
+
+  std::mt19937_64 gen_{0};
+
+ private:
+  IntegerThresholds saved_;
+};
+
+TEST_F(RadixConversion, SmallValues) {
+  EXPECT_EQ(Decimal({0}), "0");
+  EXPECT_EQ(Decimal({0, 0}), "0");
+  EXPECT_EQ(Decimal({42, 0}), "42");
+  EXPECT_EQ(Decimal({0, 1}), "18446744073709551616");
+
+  std::string hex(32, '\0');
+  uint64_t limbs[] = {0xabc, 0x1f, 0};
+  hex.resize(ToHexadecimal(hex.data(), limbs, 3) - hex.data());
+  EXPECT_EQ(hex, "1f0000000000000abc");
+}
+
+TEST_F(RadixConversion, DigitsBound) {
+  for (size_t n = 1; n < 200; ++n) {
+    std::vector<uint64_t> a(n, ~uint64_t{0});
+    EXPECT_LE(Decimal(a).size(), DecimalDigitsBound(n));
+  }
+}
+
+TEST_F(RadixConversion, RecursiveMatchesSchoolbook) {
+  for (size_t n : {2, 3, 5, 17, 64, 200, 513}) {
+    for (int trial = 0; trial < 3; ++trial) {
+      auto a = RandomNormalizedLimbs(n, gen_);
+      GlobalIntegerThresholds().radix_conversion = 1000000;
+      std::string expected                       = Decimal(a);
+      for (size_t threshold : {2, 3, 8}) {
+        GlobalIntegerThresholds().radix_conversion = threshold;
+        EXPECT_EQ(Decimal(a), expected) << "n = " << n;
+      }
+    }
+  }
+}
+
+std::vector<uint64_t> ParseDecimal(std::string const &digits) {
+  std::vector<uint64_t> result(DecimalLimbs(digits.size()));
+  FromDecimal(result.data(), digits.data(), digits.size());
+  result.resize(std::max<size_t>(Normalized(result.data(), result.size()), 1));
+  return result;
+}
+
+TEST_F(RadixConversion, ParseDecimal) {
+  EXPECT_EQ(ParseDecimal("0"), std::vector<uint64_t>{0});
+  EXPECT_EQ(ParseDecimal(std::string(25, '0')), std::vector<uint64_t>{0});
+  EXPECT_EQ(ParseDecimal("18446744073709551615"),
+            std::vector<uint64_t>{~uint64_t{0}});
+  EXPECT_EQ(ParseDecimal("18446744073709551616"),
+            (std::vector<uint64_t>{0, 1}));
+}
+
+TEST_F(RadixConversion, ParseHexadecimal) {
+  std::string digits = "1F0000000000000aBc";
+  std::vector<uint64_t> result(HexadecimalLimbs(digits.size()));
+  FromHexadecimal(result.data(), digits.data(), digits.size());
+  EXPECT_EQ(result, (std::vector<uint64_t>{0xabc, 0x1f}));
+}
+
+TEST_F(RadixConversion, ParseRoundTrip) {
+  for (size_t n : {1, 2, 3, 5, 17, 64, 200, 513}) {
+    for (int trial = 0; trial < 3; ++trial) {
+      auto a = RandomNormalizedLimbs(n, gen_);
+      GlobalIntegerThresholds().radix_conversion = 1000000;
+      std::string digits                         = Decimal(a);
+      for (size_t threshold : {2, 3, 8, 1000000}) {
+        GlobalIntegerThresholds().radix_conversion = threshold;
+        EXPECT_EQ(ParseDecimal(digits), a) << "n = " << n;
+      }
+    }
+  }
+}
+
+TEST_F(RadixConversion, ConcurrentConversions) {
+  // Conversions of different lengths extend the shared powers concurrently.
+  GlobalIntegerThresholds().radix_conversion = 2;
+  std::vector<std::vector<uint64_t>> values;
+  for (size_t n : {4000, 3000, 1000, 300, 40}) {
+    values.push_back(RandomNormalizedLimbs(n, gen_));
+  }
+  std::vector<std::string> digits(values.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < values.size(); ++i) {
+    threads.emplace_back([&, i] { digits[i] = Decimal(values[i]); });
+  }
+  for (std::thread &t : threads) { t.join(); }
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(ParseDecimal(digits[i]), values[i]);
+  }
+}
+
+}  // namespace
+}  // namespace chalk::internal_integer
@@ -0,0 +1,70 @@
+#ifndef CHALK_INTERNAL_SLIDING_WINDOW_H
+#define CHALK_INTERNAL_SLIDING_WINDOW_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace chalk::internal_integer {
+
+// Returns the number of bits in the non-zero exponent `e[0, n)`, whose most
+// significant limb must be non-zero.
+inline size_t ExponentBits(uint64_t const *e, size_t n) {
+  return 64 * (n - 1) + std::bit_width(e[n - 1]);
+}
+
+// Returns the number of bits `k` in each window of an exponent of `bits` bits,
+// balancing the `2^(k - 1)` multiplications needed to build the table of odd
+// powers against the roughly `bits / (k + 1)` multiplications by its entries.
+inline int WindowBits(size_t bits) {
+  if (bits > 671) { return 6; }
+  if (bits > 239) { return 5; }
+  if (bits > 79) { return 4; }
+  if (bits > 23) { return 3; }
+  return 1;
+}
+
+// Drives left-to-right sliding-window exponentiation by the non-zero exponent
+// `e[0, n)`, least significant limb first, with windows of at most `k` bits.
+// The caller holds a table of the odd powers `a^1, a^3, ..., a^(2^k - 1)` of
+// the base. `start(i)` sets the power to entry `i` of the table, after which
+// `square()` squares it and `multiply(i)` multiplies it by entry `i`. Each
+// window costs one multiplication in addition to a squaring per bit.
+template <typename Start, typename Square, typename Multiply>
+void SlidingWindow(uint64_t const *e, size_t n, int k, Start &&start,
+                   Square &&square, Multiply &&multiply) {
+  size_t bits = ExponentBits(e, n);
+  auto bit    = [&](size_t i) { return (e[i / 64] >> (i % 64)) & 1; };
+
+  // Returns the odd value of the longest window of at most `k` bits whose top
+  // bit is `top`, setting `length` to its length.
+  auto window = [&](size_t top, size_t &length) {
+    size_t bottom = top + 1 >= static_cast<size_t>(k) ? top + 1 - k : 0;
+    while (not bit(bottom)) { ++bottom; }
+    size_t value = 0;
+    for (size_t i = top + 1; i-- > bottom;) { value = 2 * value + bit(i); }
+    length = top + 1 - bottom;
+    return value;
+  };
+
+  // The leading bit is set, so the first window starts the power rather than
+  // being multiplied into one.
+  size_t length;
+  start(window(bits - 1, length) / 2);
+  size_t position = bits - length;
+  while (position > 0) {
+    if (not bit(position - 1)) {
+      square();
+      --position;
+      continue;
+    }
+    size_t value = window(position - 1, length);
+    for (size_t i = 0; i < length; ++i) { square(); }
+    multiply(value / 2);
+    position -= length;
+  }
+}
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_SLIDING_WINDOW_H
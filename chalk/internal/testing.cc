@@ -0,0 +1,26 @@
+#include "chalk/internal/testing.h"
+
+#include <cassert>
+
+namespace chalk::internal_integer {
+
+std::vector<uint64_t> RandomLimbs(size_t n, std::mt19937_64 &gen) {
+  std::vector<uint64_t> result(n);
+  for (uint64_t &limb : result) {
+    switch (gen() % 4) {
+      case 0: limb = 0; break;
+      case 1: limb = ~uint64_t{0}; break;
+      default: limb = gen(); break;
+    }
+  }
+  return result;
+}
+
+std::vector<uint64_t> RandomNormalizedLimbs(size_t n, std::mt19937_64 &gen) {
+  assert(n >= 1);
+  std::vector<uint64_t> result = RandomLimbs(n, gen);
+  if (result.back() == 0) { result.back() = 1; }
+  return result;
+}
+
+}  // namespace chalk::internal_integer
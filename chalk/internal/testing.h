@@ -0,0 +1,21 @@
+#ifndef CHALK_INTERNAL_TESTING_H
+#define CHALK_INTERNAL_TESTING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace chalk::internal_integer {
+
+// Returns `n` random limbs, biased towards zero and all-ones limbs, which are
+// most likely to expose carry bugs.
+std::vector<uint64_t> RandomLimbs(size_t n, std::mt19937_64 &gen);
+
+// As above, but with a non-zero most significant limb, so that the value has
+// exactly `n` limbs. Requires `n >= 1`.
+std::vector<uint64_t> RandomNormalizedLimbs(size_t n, std::mt19937_64 &gen);
+
+}  // namespace chalk::internal_integer
+
+#endif  // CHALK_INTERNAL_TESTING_H
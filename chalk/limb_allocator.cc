@@ -0,0 +1,142 @@
+#include "chalk/limb_allocator.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <new>
+
+namespace chalk {
+namespace {
+
+uint64_t *AllocateFromHeap(size_t n) {
+  return static_cast<uint64_t *>(::operator new(n * sizeof(uint64_t)));
+}
+
+void DeallocateToHeap(uint64_t *ptr, size_t n) {
+  ::operator delete(ptr, n * sizeof(uint64_t));
+}
+
+// Blocks of more than `2^kSizeClasses - 1` limbs are not cached, and no class
+// caches more than `kMaximumBlocks` blocks, bounding the memory a thread may
+// hold on to at a little under one megabyte.
+constexpr size_t kSizeClasses  = 11;
+constexpr size_t kMaximumBlocks = 32;
+
+size_t SizeClass(size_t n) { return std::bit_width(n - 1); }
+
+// Set once the calling thread's pool has been destroyed, after which any
+// `Integer`s with static or thread storage duration destroyed later on the
+// thread go directly to the heap.
+thread_local bool pool_destroyed = false;
+
+// A thread's cache of freed blocks. Size class `c` holds blocks of exactly
+// `2^c` limbs, threaded into a singly-linked list through their first limb.
+struct LimbPool {
+  ~LimbPool() {
+    for (size_t c = 0; c < kSizeClasses; ++c) {
+      while (uint64_t *block = lists[c]) {
+        lists[c] = reinterpret_cast<uint64_t *>(block[0]);
+        DeallocateToHeap(block, size_t{1} << c);
+      }
+    }
+    pool_destroyed = true;
+  }
+
+  uint64_t *Allocate(size_t n) {
+    size_t c = SizeClass(n);
+    if (c < kSizeClasses and lists[c] != nullptr) {
+      uint64_t *block = lists[c];
+      lists[c]        = reinterpret_cast<uint64_t *>(block[0]);
+      --counts[c];
+      return block;
+    }
+    return AllocateFromHeap(LimbBlockSize(n));
+  }
+
+  void Deallocate(uint64_t *ptr, size_t n) {
+    size_t c = SizeClass(n);
+    if (c >= kSizeClasses or counts[c] == kMaximumBlocks) {
+      return DeallocateToHeap(ptr, LimbBlockSize(n));
+    }
+    ptr[0]   = reinterpret_cast<uintptr_t>(lists[c]);
+    lists[c] = ptr;
+    ++counts[c];
+  }
+
+  std::array<uint64_t *, kSizeClasses> lists = {};
+  std::array<size_t, kSizeClasses> counts    = {};
+};
+
+LimbPool &ThreadLimbPool() {
+  thread_local LimbPool pool;
+  return pool;
+}
+
+// Stateless, so that blocks may be freed on a thread other than the one that
+// allocated them, including after the allocating thread has exited.
+struct PoolingLimbAllocator final : LimbAllocator {
+  uint64_t *Allocate(size_t n) override {
+    if (pool_destroyed) { return AllocateFromHeap(LimbBlockSize(n)); }
+    return ThreadLimbPool().Allocate(n);
+  }
+  void Deallocate(uint64_t *ptr, size_t n) override {
+    if (pool_destroyed) { return DeallocateToHeap(ptr, LimbBlockSize(n)); }
+    ThreadLimbPool().Deallocate(ptr, n);
+  }
+};
+
+LimbAllocator *&ThreadCurrentAllocator() {
+  thread_local LimbAllocator *allocator = &DefaultLimbAllocator();
+  return allocator;
+}
+
+}  // namespace
+
+LimbAllocator &DefaultLimbAllocator() {
+  static PoolingLimbAllocator allocator;
+  return allocator;
+}
+
+size_t LimbBlockSize(size_t n) {
+  size_t c = SizeClass(n);
+  return c < kSizeClasses ? size_t{1} << c : n;
+}
+
+LimbAllocator &CurrentLimbAllocator() { return *ThreadCurrentAllocator(); }
+
+ScopedLimbAllocator::ScopedLimbAllocator(LimbAllocator &allocator)
+    : previous_(ThreadCurrentAllocator()) {
+  ThreadCurrentAllocator() = &allocator;
+}
+
+ScopedLimbAllocator::~ScopedLimbAllocator() {
+  ThreadCurrentAllocator() = previous_;
+}
+
+LimbArena::LimbArena(size_t initial_block_size)
+    : next_block_size_(std::max<size_t>(initial_block_size, 1)) {}
+
+LimbArena::~LimbArena() {
+  for (auto [data, size] : blocks_) { DeallocateToHeap(data, size); }
+}
+
+uint64_t *LimbArena::Allocate(size_t n) {
+  if (static_cast<size_t>(limit_ - next_) < n) {
+    size_t size = std::max(next_block_size_, n);
+    next_block_size_ *= 2;
+    blocks_.push_back({AllocateFromHeap(size), size});
+    reserved_ += size;
+    next_  = blocks_.back().data;
+    limit_ = next_ + size;
+  }
+  uint64_t *result = next_;
+  next_ += n;
+  return result;
+}
+
+void LimbArena::Deallocate(uint64_t *ptr, size_t n) {
+  if (ptr + n == next_) { next_ = ptr; }
+}
+
+}  // namespace chalk
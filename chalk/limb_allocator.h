@@ -0,0 +1,91 @@
+#ifndef CHALK_LIMB_ALLOCATOR_H
+#define CHALK_LIMB_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chalk {
+
+// An allocation policy for the limbs of `Integer`s too large to be stored
+// inline. Each heap-allocated `Integer` remembers the allocator its limbs came
+// from and returns them to it, so allocators may be changed freely while
+// `Integer`s are alive.
+struct LimbAllocator {
+  virtual ~LimbAllocator() = default;
+
+  // Returns storage for `n` limbs, where `n` is positive.
+  virtual uint64_t *Allocate(size_t n) = 0;
+
+  // Releases storage previously returned by `Allocate(n)`. May be called from
+  // any thread.
+  virtual void Deallocate(uint64_t *ptr, size_t n) = 0;
+};
+
+// Returns the allocator used unless another is installed with
+// `ScopedLimbAllocator`. It keeps recently freed blocks in thread-local
+// freelists segregated by power-of-two size classes, so that the many short
+// lived values of a computation are recycled without touching, or contending
+// on, the global heap. Blocks larger than the largest size class go directly to
+// the global heap.
+LimbAllocator &DefaultLimbAllocator();
+
+// Returns the number of limbs `DefaultLimbAllocator()` reserves to satisfy a
+// request for `n` limbs. Requests of exactly this size leave no part of the
+// block unused.
+size_t LimbBlockSize(size_t n);
+
+// Returns the allocator from which `Integer`s on the calling thread obtain
+// their limbs.
+LimbAllocator &CurrentLimbAllocator();
+
+// Installs `allocator` as the calling thread's current allocator for the
+// lifetime of this object, restoring the previous allocator afterwards. Scopes
+// may be nested but must be destroyed in the reverse order of construction.
+struct ScopedLimbAllocator {
+  explicit ScopedLimbAllocator(LimbAllocator &allocator);
+  ScopedLimbAllocator(ScopedLimbAllocator const &)            = delete;
+  ScopedLimbAllocator &operator=(ScopedLimbAllocator const &) = delete;
+  ~ScopedLimbAllocator();
+
+ private:
+  LimbAllocator *previous_;
+};
+
+// A bump allocator which carves limbs out of large blocks and releases them
+// all at once when destroyed. Deallocation reclaims storage only when it is the
+// most recent allocation, which makes arenas well suited to scoped
+// computations with stack-like lifetimes. Every `Integer` allocated from an
+// arena must be destroyed before the arena is; results which must outlive it
+// should be copied after the `ScopedLimbAllocator` installing the arena has
+// been destroyed. Arenas are not synchronized, so an arena and the `Integer`s
+// allocated from it may only be used by one thread at a time.
+struct LimbArena final : LimbAllocator {
+  // Creates an arena whose first block holds `initial_block_size` limbs.
+  // Subsequent blocks double in size.
+  explicit LimbArena(size_t initial_block_size = 4096);
+  LimbArena(LimbArena const &)            = delete;
+  LimbArena &operator=(LimbArena const &) = delete;
+  ~LimbArena() override;
+
+  uint64_t *Allocate(size_t n) override;
+  void Deallocate(uint64_t *ptr, size_t n) override;
+
+  // Returns the number of limbs currently reserved from the global heap.
+  size_t reserved() const { return reserved_; }
+
+ private:
+  struct Block {
+    uint64_t *data;
+    size_t size;
+  };
+  std::vector<Block> blocks_;
+  uint64_t *next_  = nullptr;
+  uint64_t *limit_ = nullptr;
+  size_t next_block_size_;
+  size_t reserved_ = 0;
+};
+
+}  // namespace chalk
+
+#endif  // CHALK_LIMB_ALLOCATOR_H
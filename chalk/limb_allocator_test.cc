@@ -0,0 +1,153 @@
+#include "chalk/limb_allocator.h"
+
+#include <thread>
+#include <vector>
+
+#include "chalk/integer.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk {
+namespace {
+
+Integer Factorial(size_t n) {
+  Integer result = 1;
+  for (size_t i = 2; i <= n; ++i) { result *= i; }
+  return result;
+}
+
+// Forwards to the default allocator, counting the limbs outstanding.
+struct CountingAllocator : LimbAllocator {
+  uint64_t *Allocate(size_t n) override {
+    outstanding += n;
+    unused += LimbBlockSize(n) - n;
+    ++allocations;
+    return DefaultLimbAllocator().Allocate(n);
+  }
+  void Deallocate(uint64_t *ptr, size_t n) override {
+    outstanding -= n;
+    DefaultLimbAllocator().Deallocate(ptr, n);
+  }
+
+  size_t outstanding = 0;
+  size_t unused      = 0;
+  size_t allocations = 0;
+};
+
+TEST(LimbAllocator, DefaultIsCurrent) {
+  EXPECT_EQ(&CurrentLimbAllocator(), &DefaultLimbAllocator());
+}
+
+TEST(LimbAllocator, DefaultRecyclesBlocks) {
+  LimbAllocator &allocator = DefaultLimbAllocator();
+  uint64_t *ptr            = allocator.Allocate(5);
+  allocator.Deallocate(ptr, 5);
+  // Requests in the same size class reuse the block.
+  uint64_t *reused = allocator.Allocate(7);
+  EXPECT_EQ(reused, ptr);
+  allocator.Deallocate(reused, 7);
+
+  uint64_t *large = allocator.Allocate(1 << 20);
+  large[(1 << 20) - 1] = 1;
+  allocator.Deallocate(large, 1 << 20);
+}
+
+TEST(LimbAllocator, IntegersFillBlocks) {
+  EXPECT_EQ(LimbBlockSize(5), 8u);
+  EXPECT_EQ(LimbBlockSize(8), 8u);
+  EXPECT_EQ(LimbBlockSize(1 << 20), size_t{1} << 20);
+
+  CountingAllocator counting;
+  ScopedLimbAllocator scope(counting);
+  // Growing a value and copying it at every size requests only whole blocks.
+  Integer n = 1;
+  std::vector<Integer> copies;
+  for (size_t i = 2; i <= 300; ++i) {
+    n *= i;
+    copies.push_back(n);
+  }
+  EXPECT_GT(counting.allocations, 0u);
+  EXPECT_EQ(counting.unused, 0u);
+}
+
+TEST(LimbAllocator, ScopedAllocator) {
+  CountingAllocator counting;
+  Integer outlives_scope;
+  {
+    ScopedLimbAllocator scope(counting);
+    EXPECT_EQ(&CurrentLimbAllocator(), &counting);
+    Integer small = 12345;
+    EXPECT_EQ(counting.allocations, 0u);
+    outlives_scope = Factorial(100);
+    EXPECT_GT(counting.allocations, 0u);
+    EXPECT_GT(counting.outstanding, 0u);
+  }
+  EXPECT_EQ(&CurrentLimbAllocator(), &DefaultLimbAllocator());
+
+  // Limbs are returned to the allocator they came from, even once it is no
+  // longer current.
+  outlives_scope = 0;
+  EXPECT_EQ(counting.outstanding, 0u);
+}
+
+TEST(LimbAllocator, NestedScopes) {
+  CountingAllocator outer, inner;
+  ScopedLimbAllocator outer_scope(outer);
+  {
+    ScopedLimbAllocator inner_scope(inner);
+    EXPECT_EQ(&CurrentLimbAllocator(), &inner);
+  }
+  EXPECT_EQ(&CurrentLimbAllocator(), &outer);
+}
+
+TEST(LimbAllocator, ScopesArePerThread) {
+  CountingAllocator counting;
+  ScopedLimbAllocator scope(counting);
+  std::thread([] {
+    EXPECT_EQ(&CurrentLimbAllocator(), &DefaultLimbAllocator());
+  }).join();
+}
+
+TEST(LimbAllocator, CrossThreadRelease) {
+  std::vector<Integer> values;
+  std::thread([&] {
+    for (size_t n = 30; n < 60; ++n) { values.push_back(Factorial(n)); }
+  }).join();
+  // The allocating thread has exited; release on this thread instead.
+  EXPECT_EQ(values.back(), Factorial(59));
+  values.clear();
+}
+
+TEST(LimbArena, BumpAllocation) {
+  LimbArena arena(16);
+  uint64_t *a = arena.Allocate(4);
+  uint64_t *b = arena.Allocate(4);
+  EXPECT_EQ(b, a + 4);
+  EXPECT_EQ(arena.reserved(), 16u);
+
+  // Only the most recent allocation is reclaimed.
+  arena.Deallocate(a, 4);
+  EXPECT_EQ(arena.Allocate(4), b + 4);
+  arena.Deallocate(b + 4, 4);
+  EXPECT_EQ(arena.Allocate(4), b + 4);
+
+  // Requests exceeding the current block start a new one.
+  uint64_t *large = arena.Allocate(100);
+  large[99]       = 1;
+  EXPECT_EQ(arena.reserved(), 16u + 100u);
+}
+
+TEST(LimbArena, ScopedComputation) {
+  LimbArena arena;
+  Integer result;
+  {
+    ScopedLimbAllocator scope(arena);
+    Integer n = Factorial(300);
+    EXPECT_GT(arena.reserved(), 0u);
+    result = n / Factorial(298);
+  }
+  EXPECT_EQ(result, 300 * 299);
+}
+
+}  // namespace
+}  // namespace chalk
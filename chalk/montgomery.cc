@@ -0,0 +1,133 @@
+#include "chalk/montgomery.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "chalk/internal/divide.h"
+#include "chalk/internal/montgomery.h"
+#include "chalk/internal/multiply.h"
+#include "chalk/internal/sliding_window.h"
+
+namespace chalk {
+namespace {
+
+// Returns `2^(64 * shift) mod m[0, n)`.
+std::vector<uint64_t> PowerOfTwoRemainder(size_t shift, uint64_t const *m,
+                                          size_t n) {
+  std::vector<uint64_t> power(shift + 1, 0);
+  power.back() = 1;
+  std::vector<uint64_t> quotient(shift + 2 - n), remainder(n);
+  internal_integer::DivRem(quotient.data(), remainder.data(), power.data(),
+                           power.size(), m, n);
+  return remainder;
+}
+
+}  // namespace
+
+MontgomeryContext::MontgomeryContext(Integer const &modulus)
+    : modulus_(modulus),
+      modulus_limbs_(modulus.limbs(), modulus.limbs() + modulus.size()) {
+  assert(modulus > 1);
+  assert(modulus_limbs_[0] % 2 == 1);
+  size_t n   = size();
+  r_squared_ = PowerOfTwoRemainder(2 * n, modulus_limbs_.data(), n);
+  one_       = PowerOfTwoRemainder(n, modulus_limbs_.data(), n);
+  inverse_   = internal_integer::NegatedInverse(modulus_limbs_[0]);
+}
+
+size_t MontgomeryContext::scratch_size() const {
+  // The unreduced product, followed by the storage of the multiplication.
+  return 2 * size() + internal_integer::MultiplyScratchSize(size());
+}
+
+void MontgomeryContext::ToMontgomery(uint64_t *r, Integer const &a) const {
+  Integer reduced = a % modulus_;
+  if (Integer::IsNegative(reduced)) { reduced += modulus_; }
+  std::fill(std::copy(reduced.limbs(), reduced.limbs() + reduced.size(), r),
+            r + size(), 0);
+  std::vector<uint64_t> scratch(scratch_size());
+  Multiply(r, r, r_squared_.data(), scratch.data());
+}
+
+Integer MontgomeryContext::FromMontgomery(uint64_t const *a) const {
+  size_t n = size();
+  std::vector<uint64_t> t(2 * n, 0);
+  std::copy(a, a + n, t.begin());
+  Integer result;
+  result.EnsureCapacity(n);
+  internal_integer::MontgomeryReduce(result.limbs(), t.data(),
+                                     modulus_limbs_.data(), n, inverse_);
+  result.set_size(n);
+  result.ShrinkToFit();
+  return result;
+}
+
+void MontgomeryContext::One(uint64_t *r) const {
+  std::copy(one_.begin(), one_.end(), r);
+}
+
+void MontgomeryContext::Multiply(uint64_t *r, uint64_t const *a,
+                                 uint64_t const *b, uint64_t *scratch) const {
+  size_t n = size();
+  internal_integer::MultiplyWithScratch(scratch, a, b, n, scratch + 2 * n);
+  internal_integer::MontgomeryReduce(r, scratch, modulus_limbs_.data(), n,
+                                     inverse_);
+}
+
+void MontgomeryContext::Square(uint64_t *r, uint64_t const *a,
+                               uint64_t *scratch) const {
+  size_t n = size();
+  internal_integer::SquareWithScratch(scratch, a, n, scratch + 2 * n);
+  internal_integer::MontgomeryReduce(r, scratch, modulus_limbs_.data(), n,
+                                     inverse_);
+}
+
+size_t MontgomeryContext::PowScratchSize(Integer const &exponent) const {
+  size_t bits =
+      internal_integer::ExponentBits(exponent.limbs(), exponent.size());
+  size_t table_size = size_t{1} << (internal_integer::WindowBits(bits) - 1);
+  return scratch_size() + (table_size + 1) * size();
+}
+
+void MontgomeryContext::Pow(uint64_t *r, uint64_t const *a,
+                            Integer const &exponent, uint64_t *scratch) const {
+  assert(not Integer::IsNegative(exponent));
+  if (exponent.IsZero()) {
+    One(r);
+    return;
+  }
+
+  uint64_t const *e = exponent.limbs();
+  size_t en         = exponent.size();
+  int k = internal_integer::WindowBits(internal_integer::ExponentBits(e, en));
+
+  // The table holds `a^1, a^3, ..., a^(2^k - 1)`, built from `a^2`. It is
+  // filled before `r` is written, as `r` may alias `a`.
+  size_t n          = size();
+  uint64_t *product = scratch;
+  uint64_t *square  = product + scratch_size();
+  uint64_t *table   = square + n;
+  std::copy(a, a + n, table);
+  if (k > 1) {
+    Square(square, a, product);
+    for (size_t i = 1; i < (size_t{1} << (k - 1)); ++i) {
+      Multiply(table + i * n, table + (i - 1) * n, square, product);
+    }
+  }
+
+  internal_integer::SlidingWindow(
+      e, en, k,
+      [&](size_t i) { std::copy(table + i * n, table + (i + 1) * n, r); },
+      [&] { Square(r, r, product); },
+      [&](size_t i) { Multiply(r, r, table + i * n, product); });
+}
+
+Integer MontgomeryContext::Pow(Integer const &base,
+                               Integer const &exponent) const {
+  std::vector<uint64_t> buffer(size() + PowScratchSize(exponent));
+  ToMontgomery(buffer.data(), base);
+  Pow(buffer.data(), buffer.data(), exponent, buffer.data() + size());
+  return FromMontgomery(buffer.data());
+}
+
+}  // namespace chalk
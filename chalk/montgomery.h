@@ -0,0 +1,87 @@
+#ifndef CHALK_MONTGOMERY_H
+#define CHALK_MONTGOMERY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "chalk/integer.h"
+
+namespace chalk {
+
+// Arithmetic modulo a fixed odd modulus `m` of `n` limbs, with residues in
+// Montgomery form: a residue `a` is represented by `a * R mod m`, where
+// `R = 2^(64 * n)`. Products in this form are reduced by Montgomery's REDC,
+// which replaces division by `m` with multiplication by the precomputed
+// `-m^-1 mod 2^64` and a shift by whole limbs. Converting in and out of the
+// form costs a multiplication each, so it pays off over long chains of
+// operations such as exponentiation.
+//
+// Residues in Montgomery form are buffers of exactly `size()` limbs, least
+// significant first, holding a value less than `m`. Multiplication, squaring
+// and exponentiation take their temporary storage from a caller-provided
+// `scratch` buffer, and their output may alias any of their inputs. They never
+// allocate for moduli shorter than the Toom-3 threshold of
+// `GlobalIntegerThresholds()`; the Toom-3 and number-theoretic products used
+// for longer moduli allocate temporaries of their own. A context may be shared
+// freely between threads.
+struct MontgomeryContext {
+  // Requires `modulus` to be odd and greater than one.
+  explicit MontgomeryContext(Integer const &modulus);
+
+  Integer const &modulus() const { return modulus_; }
+
+  // The number of limbs in a residue.
+  size_t size() const { return modulus_limbs_.size(); }
+
+  // The number of limbs required of the `scratch` buffers below, under the
+  // thresholds in effect when it is called.
+  size_t scratch_size() const;
+
+  // Sets `r` to the Montgomery form of `a mod m`. `a` may be negative or at
+  // least `m`.
+  void ToMontgomery(uint64_t *r, Integer const &a) const;
+
+  // Returns the value in `[0, m)` of the residue whose Montgomery form is `a`.
+  Integer FromMontgomery(uint64_t const *a) const;
+
+  // Sets `r` to the Montgomery form of one.
+  void One(uint64_t *r) const;
+
+  // Sets `r` to the Montgomery form of the product of the residues `a` and
+  // `b`. Products of more than `GlobalIntegerThresholds()` limbs use the
+  // corresponding subquadratic multiplication before reduction.
+  void Multiply(uint64_t *r, uint64_t const *a, uint64_t const *b,
+                uint64_t *scratch) const;
+
+  // As `Multiply(r, a, a, scratch)`, using the dedicated squaring kernels.
+  void Square(uint64_t *r, uint64_t const *a, uint64_t *scratch) const;
+
+  // Sets `r` to the Montgomery form of `a` raised to the non-negative
+  // `exponent`, by left-to-right sliding-window exponentiation. The window
+  // grows with the length of the exponent, and each window costs one
+  // multiplication by a precomputed odd power of `a` in addition to a
+  // squaring per bit. `scratch` must have room for `PowScratchSize(exponent)`
+  // limbs, which hold the table of odd powers.
+  void Pow(uint64_t *r, uint64_t const *a, Integer const &exponent,
+           uint64_t *scratch) const;
+  size_t PowScratchSize(Integer const &exponent) const;
+
+  // Returns `base` raised to the non-negative `exponent`, modulo `m`, in
+  // `[0, m)`. Converts in and out of Montgomery form, allocating the storage
+  // for the exponentiation once.
+  Integer Pow(Integer const &base, Integer const &exponent) const;
+
+ private:
+  Integer modulus_;
+  std::vector<uint64_t> modulus_limbs_;
+  // `R^2 mod m` and `R mod m`, the Montgomery forms of `R` and one.
+  std::vector<uint64_t> r_squared_;
+  std::vector<uint64_t> one_;
+  // `-m^-1 mod 2^64`.
+  uint64_t inverse_;
+};
+
+}  // namespace chalk
+
+#endif  // CHALK_MONTGOMERY_H
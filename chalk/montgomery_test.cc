@@ -0,0 +1,174 @@
+#include "chalk/montgomery.h"
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "chalk/integer.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Counts every allocation made through the global `operator new`.
+size_t global_allocations = 0;
+
+}  // namespace
+
+void *operator new(size_t size) {
+  ++global_allocations;
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) { return ptr; }
+  throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace chalk {
+namespace {
+
+Integer PowerOfTwo(size_t n) {
+  Integer result = 1;
+  for (size_t i = 0; i < n; ++i) { result *= 2; }
+  return result;
+}
+
+Integer Factorial(size_t n) {
+  Integer result = 1;
+  for (size_t i = 2; i <= n; ++i) { result *= i; }
+  return result;
+}
+
+// Returns `base^exponent mod m` by binary exponentiation with a division after
+// every step.
+Integer ReferencePow(Integer base, uint64_t exponent, Integer const &m) {
+  Integer result = 1;
+  base           = base % m;
+  if (base < 0) { base += m; }
+  while (exponent != 0) {
+    if (exponent % 2 == 1) { result = result * base % m; }
+    base = base * base % m;
+    exponent /= 2;
+  }
+  return result % m;
+}
+
+TEST(MontgomeryContext, ConversionRoundTrip) {
+  for (Integer m : {Integer(3), Integer(~uint64_t{0}), Factorial(30) + 1,
+                    PowerOfTwo(500) - 1}) {
+    MontgomeryContext context(m);
+    std::vector<uint64_t> buffer(context.size());
+    for (Integer a : {Integer(0), Integer(1), Integer(2), m - 1, m, m + 5,
+                      -Integer(1), -m - 2, Factorial(40)}) {
+      context.ToMontgomery(buffer.data(), a);
+      Integer expected = a % m;
+      if (expected < 0) { expected += m; }
+      EXPECT_EQ(context.FromMontgomery(buffer.data()), expected);
+    }
+    context.One(buffer.data());
+    EXPECT_EQ(context.FromMontgomery(buffer.data()), 1);
+  }
+}
+
+TEST(MontgomeryContext, MultiplyAndSquare) {
+  for (Integer m : {Integer(101), Factorial(25) + 1, Factorial(200) - 1}) {
+    MontgomeryContext context(m);
+    size_t n = context.size();
+    std::vector<uint64_t> a(n), b(n), r(n), scratch(context.scratch_size());
+    Integer x = Factorial(300) + 17;
+    Integer y = -Factorial(150) - 3;
+    context.ToMontgomery(a.data(), x);
+    context.ToMontgomery(b.data(), y);
+
+    Integer product = x * y % m;
+    if (product < 0) { product += m; }
+    context.Multiply(r.data(), a.data(), b.data(), scratch.data());
+    EXPECT_EQ(context.FromMontgomery(r.data()), product);
+    context.Square(r.data(), a.data(), scratch.data());
+    EXPECT_EQ(context.FromMontgomery(r.data()), x * x % m);
+
+    // Outputs may alias inputs.
+    context.Multiply(a.data(), a.data(), b.data(), scratch.data());
+    EXPECT_EQ(context.FromMontgomery(a.data()), product);
+    context.Square(b.data(), b.data(), scratch.data());
+    EXPECT_EQ(context.FromMontgomery(b.data()), y * y % m);
+  }
+}
+
+TEST(MontgomeryContext, KaratsubaSizedModulus) {
+  // About a hundred limbs, between the Karatsuba and Toom-3 thresholds.
+  Integer m = Factorial(900) + 1;
+  MontgomeryContext context(m);
+  size_t n = context.size();
+  std::vector<uint64_t> a(n), b(n), scratch(context.scratch_size());
+  Integer x = Factorial(1000) + 17;
+  Integer y = Factorial(950) - 3;
+  context.ToMontgomery(a.data(), x);
+  context.ToMontgomery(b.data(), y);
+
+  size_t allocations = global_allocations;
+  for (int i = 0; i < 10; ++i) {
+    context.Multiply(a.data(), a.data(), b.data(), scratch.data());
+    context.Square(b.data(), b.data(), scratch.data());
+  }
+  EXPECT_EQ(global_allocations, allocations);
+
+  for (int i = 0; i < 10; ++i) {
+    x = x * y % m;
+    y = y * y % m;
+  }
+  EXPECT_EQ(context.FromMontgomery(a.data()), x);
+  EXPECT_EQ(context.FromMontgomery(b.data()), y);
+}
+
+TEST(MontgomeryContext, PowMatchesReference) {
+  // Exponents of these lengths exercise every window size.
+  for (Integer m : {Integer(1000003), Integer(~uint64_t{0}),
+                    Factorial(20) * Factorial(20) + 1, Factorial(100) + 1,
+                    PowerOfTwo(1000) + 1}) {
+    MontgomeryContext context(m);
+    for (uint64_t exponent :
+         {uint64_t{0}, uint64_t{1}, uint64_t{2}, uint64_t{3}, uint64_t{255},
+          uint64_t{1} << 20, uint64_t{0x123456789}, ~uint64_t{0}}) {
+      for (Integer base : {Integer(0), Integer(2), Integer(-7), m - 1,
+                           Factorial(50) + 3}) {
+        EXPECT_EQ(context.Pow(base, exponent),
+                  ReferencePow(base, exponent, m))
+            << "m = " << m << ", base = " << base
+            << ", exponent = " << exponent;
+      }
+    }
+  }
+}
+
+TEST(MontgomeryContext, FermatLittleTheorem) {
+  // For a prime `p` and `a` not divisible by `p`, `a^(p - 1) = 1 mod p`. These
+  // exponents are long enough to use the widest windows.
+  for (size_t bits : {61, 127, 521, 607, 1279}) {
+    Integer p = PowerOfTwo(bits) - 1;
+    MontgomeryContext context(p);
+    for (Integer a : {Integer(2), Integer(3), Factorial(bits / 4) + 1}) {
+      EXPECT_EQ(context.Pow(a, p - 1), 1) << "bits = " << bits;
+      EXPECT_EQ(context.Pow(a, p), a % p) << "bits = " << bits;
+    }
+  }
+}
+
+TEST(MontgomeryContext, PowOnBuffers) {
+  Integer m = Factorial(60) + 1;
+  MontgomeryContext context(m);
+  Integer exponent = Factorial(40);
+  size_t n         = context.size();
+  std::vector<uint64_t> a(n), r(n), scratch(context.PowScratchSize(exponent));
+  context.ToMontgomery(a.data(), 12345);
+  context.Pow(r.data(), a.data(), exponent, scratch.data());
+  Integer expected = context.FromMontgomery(r.data());
+  EXPECT_EQ(expected, context.Pow(12345, exponent));
+
+  // Raising to `x * y` is raising to `x` and then to `y`.
+  context.Pow(r.data(), a.data(), Factorial(20), scratch.data());
+  context.Pow(r.data(), r.data(), exponent / Factorial(20), scratch.data());
+  EXPECT_EQ(context.FromMontgomery(r.data()), expected);
+}
+
+}  // namespace
+}  // namespace chalk
@@ -0,0 +1,112 @@
+#include "chalk/multi_modular_integer.h"
+
+#include <cassert>
+#include <vector>
+
+#include "chalk/limb_allocator.h"
+
+namespace chalk::internal_multi_modular {
+namespace {
+
+// The constants for reconstructing a value from its residues modulo the first
+// `n` primes by the Chinese remainder theorem, as
+//   `x = sum over i of (r_i * c_i mod p_i) * (M / p_i) mod M`,
+// where `c_i` is the inverse of `M / p_i` modulo `p_i`. The sum is formed over
+// a balanced binary tree of the primes: each node covering the primes
+// `[lo, hi)` holds their product, and a node's share of the sum is the share
+// of each child multiplied by the product held by the other child. Every
+// multiplication is then between operands of similar length.
+struct CrtContext {
+  explicit CrtContext(size_t n) : products(4 * n), inverses(n) {
+    BuildProducts(0, 0, n);
+    for (size_t i = 0; i < n; ++i) {
+      ResiduePrime const &prime = kResiduePrimes[i];
+      uint64_t cofactor         = prime.ToMontgomery(1);
+      for (size_t j = 0; j < n; ++j) {
+        if (j == i) { continue; }
+        cofactor = prime.Multiply(
+            cofactor, prime.ToMontgomery(kPrimes[j] % prime.modulus));
+      }
+      inverses[i] =
+          prime.FromMontgomery(prime.Power(cofactor, prime.modulus - 2));
+    }
+  }
+
+  void BuildProducts(size_t node, size_t lo, size_t hi) {
+    if (hi - lo == 1) {
+      products[node] = kPrimes[lo];
+      return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    BuildProducts(2 * node + 1, lo, mid);
+    BuildProducts(2 * node + 2, mid, hi);
+    products[node] = products[2 * node + 1] * products[2 * node + 2];
+  }
+
+  // Returns the share of the sum belonging to the primes `[lo, hi)` covered by
+  // `node`, given `terms[i] = r_i * c_i mod p_i`.
+  Integer Combine(uint64_t const *terms, size_t node, size_t lo,
+                  size_t hi) const {
+    if (hi - lo == 1) { return terms[lo]; }
+    size_t mid    = lo + (hi - lo) / 2;
+    Integer left  = Combine(terms, 2 * node + 1, lo, mid);
+    Integer right = Combine(terms, 2 * node + 2, mid, hi);
+    return left * products[2 * node + 2] + right * products[2 * node + 1];
+  }
+
+  // `products[node]` is the product of the primes covered by `node`, where the
+  // root, node 0, covers every prime, and the children of node `k` covering
+  // `[lo, hi)` are nodes `2k + 1` and `2k + 2`, covering each half.
+  std::vector<Integer> products;
+  // `c_i`, in the standard representation.
+  std::vector<uint64_t> inverses;
+};
+
+CrtContext const &Context(size_t n) {
+  assert(n > 0 and n <= kMaxPrimes);
+  // The initialization of a function-local static is thread-safe. The contexts
+  // outlive any allocator the first caller may have installed, so they are
+  // built with the default allocator.
+  static std::vector<CrtContext> const contexts = [] {
+    ScopedLimbAllocator scope(DefaultLimbAllocator());
+    std::vector<CrtContext> result;
+    result.reserve(kMaxPrimes);
+    for (size_t i = 1; i <= kMaxPrimes; ++i) { result.emplace_back(i); }
+    return result;
+  }();
+  return contexts[n - 1];
+}
+
+}  // namespace
+
+void ToResidues(uint64_t *residues, size_t n, Integer const &value) {
+  for (size_t i = 0; i < n; ++i) {
+    ResiduePrime const &prime = kResiduePrimes[i];
+    // The remainder takes the sign of `value`, and its magnitude is less than
+    // `2^62`.
+    int64_t remainder = value % prime.modulus;
+    uint64_t residue  = prime.ToMontgomery(
+        static_cast<uint64_t>(remainder < 0 ? -remainder : remainder));
+    residues[i] = remainder < 0 ? prime.Subtract(0, residue) : residue;
+  }
+}
+
+Integer FromResidues(uint64_t const *residues, size_t n) {
+  CrtContext const &context = Context(n);
+  std::vector<uint64_t> terms(n);
+  for (size_t i = 0; i < n; ++i) {
+    // Multiplying the Montgomery form of `r_i` by `c_i` removes the factor of
+    // `R`.
+    terms[i] = kResiduePrimes[i].Multiply(residues[i], context.inverses[i]);
+  }
+  // Each of the `n` terms of the sum is less than `M`, so the sum is less than
+  // `n * M` and a single division reduces it.
+  Integer const &modulus = context.products[0];
+  Integer result         = context.Combine(terms.data(), 0, 0, n) % modulus;
+  if (result * 2 > modulus) { result -= modulus; }
+  return result;
+}
+
+Integer const &Modulus(size_t n) { return Context(n).products[0]; }
+
+}  // namespace chalk::internal_multi_modular
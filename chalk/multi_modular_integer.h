@@ -0,0 +1,174 @@
+#ifndef CHALK_MULTI_MODULAR_INTEGER_H
+#define CHALK_MULTI_MODULAR_INTEGER_H
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+
+#include "chalk/algebra/property.h"
+#include "chalk/integer.h"
+#include "chalk/internal/montgomery.h"
+
+namespace chalk {
+namespace internal_multi_modular {
+
+// The largest primes below 2^62, in decreasing order. Since each is below
+// 2^62, the sum of two residues never overflows a limb.
+inline constexpr size_t kMaxPrimes = 32;
+inline constexpr std::array<uint64_t, kMaxPrimes> kPrimes = [] {
+  constexpr uint64_t kOffsets[kMaxPrimes] = {
+      57,  87,  117, 143, 153, 167, 171, 195, 203, 273, 287,
+      317, 443, 483, 495, 575, 581, 603, 633, 663, 765, 773,
+      777, 791, 813, 831, 923, 981, 993, 1001, 1007, 1017};
+  std::array<uint64_t, kMaxPrimes> primes;
+  for (size_t i = 0; i < kMaxPrimes; ++i) {
+    primes[i] = (uint64_t{1} << 62) - kOffsets[i];
+  }
+  return primes;
+}();
+
+// Arithmetic modulo one of `kPrimes`. Residues are kept in Montgomery form, in
+// the range `[0, p)`, so that each residue has a unique representation.
+using ResiduePrime = internal_integer::Montgomery64;
+
+inline constexpr std::array<ResiduePrime, kMaxPrimes> kResiduePrimes = [] {
+  return [&]<size_t... I>(std::index_sequence<I...>) {
+    return std::array<ResiduePrime, kMaxPrimes>{ResiduePrime(kPrimes[I])...};
+  }(std::make_index_sequence<kMaxPrimes>());
+}();
+
+// Sets `residues[0, n)` to the Montgomery forms of `value` modulo each of the
+// first `n` primes.
+void ToResidues(uint64_t *residues, size_t n, Integer const &value);
+
+// Returns the unique integer in `[-M / 2, M / 2)` with the given Montgomery
+// forms of residues modulo each of the first `n` primes, whose product is `M`.
+Integer FromResidues(uint64_t const *residues, size_t n);
+
+// Returns the product of the first `n` primes.
+Integer const &Modulus(size_t n);
+
+}  // namespace internal_multi_modular
+
+// `MultiModularInteger<Primes>` represents an integer by its residues modulo
+// the `Primes` largest primes below 2^62, whose product `M` is just less than
+// `2^(62 * Primes)`. It is intended for long chains of ring operations of
+// which only the final value matters: each operation acts on every residue
+// independently, without carries, allocation or data-dependent branches.
+// Addition and subtraction are independent lanes that the compiler may
+// vectorize; multiplication needs a full 64x64-bit product per residue and runs
+// as a scalar loop. The value is reconstructed by `ToInteger` with the Chinese
+// remainder theorem.
+//
+// Arithmetic is exact modulo `M`, so the reconstructed value is correct
+// whenever the true result lies in `[-M / 2, M / 2)`, regardless of the size
+// of any intermediate value. Choosing `Primes` large enough for the result is
+// the caller's responsibility; no overflow can be detected. There is no
+// division or ordering, since neither is compatible with reduction modulo
+// `M`.
+template <size_t Primes>
+struct MultiModularInteger {
+  static_assert(Primes > 0 and Primes <= internal_multi_modular::kMaxPrimes);
+  using chalk_properties = void(Ring, Commutative<'*'>);
+
+  constexpr MultiModularInteger() = default;
+
+  MultiModularInteger(std::integral auto n) {
+    bool negative = false;
+    if constexpr (std::signed_integral<decltype(n)>) { negative = n < 0; }
+    uint64_t magnitude = static_cast<uint64_t>(n);
+    if (negative) { magnitude = uint64_t{0} - magnitude; }
+    for (size_t i = 0; i < Primes; ++i) {
+      uint64_t residue = Prime(i).ToMontgomery(magnitude % Prime(i).modulus);
+      residues_[i]     = negative ? Prime(i).Subtract(0, residue) : residue;
+    }
+  }
+
+  // Reduces `n` modulo each prime, at the cost of one pass over the limbs of
+  // `n` for each.
+  explicit MultiModularInteger(Integer const &n) {
+    internal_multi_modular::ToResidues(residues_.data(), Primes, n);
+  }
+
+  // Returns the unique integer in `[-M / 2, M / 2)` congruent to the value
+  // modulo `M`. Reconstruction combines the residues over a balanced product
+  // tree of the primes, which is computed once and shared between threads.
+  Integer ToInteger() const {
+    return internal_multi_modular::FromResidues(residues_.data(), Primes);
+  }
+
+  // Returns the product `M` of the primes.
+  static Integer const &Modulus() {
+    return internal_multi_modular::Modulus(Primes);
+  }
+
+  friend bool operator==(MultiModularInteger const &lhs,
+                         MultiModularInteger const &rhs) {
+    return lhs.residues_ == rhs.residues_;
+  }
+  friend bool operator!=(MultiModularInteger const &lhs,
+                         MultiModularInteger const &rhs) {
+    return not(lhs == rhs);
+  }
+
+  MultiModularInteger &operator+=(MultiModularInteger const &rhs) {
+    for (size_t i = 0; i < Primes; ++i) {
+      residues_[i] = Prime(i).Add(residues_[i], rhs.residues_[i]);
+    }
+    return *this;
+  }
+  MultiModularInteger &operator-=(MultiModularInteger const &rhs) {
+    for (size_t i = 0; i < Primes; ++i) {
+      residues_[i] = Prime(i).Subtract(residues_[i], rhs.residues_[i]);
+    }
+    return *this;
+  }
+  MultiModularInteger &operator*=(MultiModularInteger const &rhs) {
+    for (size_t i = 0; i < Primes; ++i) {
+      residues_[i] = Prime(i).Multiply(residues_[i], rhs.residues_[i]);
+    }
+    return *this;
+  }
+  friend MultiModularInteger operator+(MultiModularInteger lhs,
+                                       MultiModularInteger const &rhs) {
+    return lhs += rhs;
+  }
+  friend MultiModularInteger operator-(MultiModularInteger lhs,
+                                       MultiModularInteger const &rhs) {
+    return lhs -= rhs;
+  }
+  friend MultiModularInteger operator*(MultiModularInteger lhs,
+                                       MultiModularInteger const &rhs) {
+    return lhs *= rhs;
+  }
+
+  MultiModularInteger operator-() const {
+    MultiModularInteger result = *this;
+    result.negate();
+    return result;
+  }
+  void negate() {
+    for (size_t i = 0; i < Primes; ++i) {
+      residues_[i] = Prime(i).Subtract(0, residues_[i]);
+    }
+  }
+
+  friend std::ostream &operator<<(std::ostream &os,
+                                  MultiModularInteger const &n) {
+    return os << n.ToInteger();
+  }
+
+ private:
+  static constexpr internal_multi_modular::ResiduePrime const &Prime(size_t i) {
+    return internal_multi_modular::kResiduePrimes[i];
+  }
+
+  std::array<uint64_t, Primes> residues_{};
+};
+
+}  // namespace chalk
+
+#endif  // CHALK_MULTI_MODULAR_INTEGER_H
@@ -0,0 +1,116 @@
+#include "chalk/multi_modular_integer.h"
+
+#include <random>
+#include <sstream>
+
+#include "chalk/algebra/dense_polynomial.h"
+#include "chalk/integer.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk {
+namespace {
+
+using ::testing::ElementsAre;
+
+static_assert(Satisfies<MultiModularInteger<1>, Ring>);
+static_assert(Satisfies<MultiModularInteger<8>, Commutative<'*'>>);
+static_assert(sizeof(MultiModularInteger<4>) == 4 * sizeof(uint64_t));
+
+TEST(MultiModularInteger, Construction) {
+  EXPECT_EQ(MultiModularInteger<3>().ToInteger(), 0);
+  EXPECT_EQ(MultiModularInteger<3>(17).ToInteger(), 17);
+  EXPECT_EQ(MultiModularInteger<3>(-17).ToInteger(), -17);
+  EXPECT_EQ(MultiModularInteger<1>(~uint64_t{0}).ToInteger(),
+            Integer(~uint64_t{0}) % MultiModularInteger<1>::Modulus());
+  EXPECT_EQ(MultiModularInteger<2>(int64_t{-1} << 63).ToInteger(),
+            int64_t{-1} << 63);
+
+  Integer big = Pow(Integer(-7), 200);
+  EXPECT_EQ(MultiModularInteger<10>(big).ToInteger(), big);
+  EXPECT_EQ(MultiModularInteger<10>(-big).ToInteger(), -big);
+  EXPECT_EQ(MultiModularInteger<10>(big), MultiModularInteger<10>(big));
+  EXPECT_NE(MultiModularInteger<10>(big), MultiModularInteger<10>(-big));
+}
+
+TEST(MultiModularInteger, Modulus) {
+  Integer expected = 1;
+  for (size_t i = 0; i < 5; ++i) {
+    expected *= internal_multi_modular::kPrimes[i];
+  }
+  EXPECT_EQ(MultiModularInteger<5>::Modulus(), expected);
+  EXPECT_EQ(MultiModularInteger<5>(expected).ToInteger(), 0);
+  EXPECT_EQ(MultiModularInteger<5>(expected + 3), 3);
+}
+
+TEST(MultiModularInteger, SymmetricRange) {
+  using M                = MultiModularInteger<4>;
+  Integer const &modulus = M::Modulus();
+  Integer half           = modulus / 2;
+  EXPECT_EQ(M(half).ToInteger(), half);
+  EXPECT_EQ(M(half + 1).ToInteger(), half + 1 - modulus);
+  EXPECT_EQ(M(-half).ToInteger(), -half);
+}
+
+TEST(MultiModularInteger, MatchesInteger) {
+  using M = MultiModularInteger<16>;
+  std::mt19937_64 gen(0);
+  // Keep the value well within the range of 16 primes.
+  Integer bound    = Pow(Integer(2), 600);
+  Integer expected = 1;
+  M value          = 1;
+  for (int i = 0; i < 200; ++i) {
+    int64_t n = static_cast<int64_t>(gen() >> 40) - (int64_t{1} << 23);
+    switch (gen() % 3) {
+      case 0:
+        expected += n;
+        value += n;
+        break;
+      case 1:
+        expected -= n;
+        value -= M(n);
+        break;
+      case 2:
+        if (expected < bound and -expected < bound) {
+          expected *= n;
+          value *= n;
+        }
+        break;
+    }
+    ASSERT_EQ(value.ToInteger(), expected);
+  }
+  EXPECT_EQ((-value).ToInteger(), -expected);
+}
+
+TEST(MultiModularInteger, IntermediateOverflow) {
+  // Intermediate values far beyond the modulus do not affect the result.
+  using M     = MultiModularInteger<2>;
+  Integer big = Pow(Integer(3), 1000);
+  M value     = M(big) * M(big);
+  value -= M(big * big);
+  value += 5;
+  EXPECT_EQ(value.ToInteger(), 5);
+}
+
+TEST(MultiModularInteger, Output) {
+  std::stringstream ss;
+  ss << MultiModularInteger<3>(-12345);
+  EXPECT_EQ(ss.str(), "-12345");
+}
+
+TEST(MultiModularInteger, Coefficients) {
+  // With `c` near `2^95`, the products pass through `c^2`, far beyond the
+  // modulus of about `2^124`, but the results lie within range.
+  using M               = MultiModularInteger<2>;
+  using polynomial_type = DensePolynomial<M>;
+  Integer c             = Pow(Integer(3), 60);
+  polynomial_type x     = polynomial_type::FromCoefficients({0, 1});
+  polynomial_type p     = x + M(c);
+  polynomial_type q     = x - M(c);
+  EXPECT_THAT((p * p - q * q).coefficients(), ElementsAre(0, M(4 * c)));
+  EXPECT_THAT((p * q + M(c * c)).coefficients(), ElementsAre(0, 0, 1));
+  EXPECT_EQ((p * p - q * q).coefficient(1).ToInteger(), 4 * c);
+}
+
+}  // namespace
+}  // namespace chalk
@@ -0,0 +1,125 @@
+#include "chalk/rational.h"
+
+#include <cassert>
+
+namespace chalk {
+
+Rational::Rational(Integer numerator, Integer denominator)
+    : numerator_(std::move(numerator)),
+      denominator_(std::move(denominator)) {
+  assert(denominator_ != 0);
+  if (Integer::IsNegative(denominator_)) {
+    numerator_.negate();
+    denominator_.negate();
+  }
+  MaybeNormalize();
+}
+
+void Rational::Normalize() {
+  if (not IsIntegral()) {
+    Integer gcd = Gcd(numerator_, denominator_);
+    if (gcd != 1) {
+      numerator_   = DivExact(numerator_, gcd);
+      denominator_ = DivExact(denominator_, gcd);
+    }
+  }
+  normalized_size_ = size();
+}
+
+void Rational::MaybeNormalize() {
+  size_t size = this->size();
+  if (size > kNormalizationLimbs and size > 2 * normalized_size_) {
+    Normalize();
+  }
+}
+
+Rational &Rational::Add(Rational const &rhs, bool subtract) {
+  if (rhs.IsIntegral()) {
+    // `a / b + c == (a + b * c) / b`, which is in lowest terms if `a / b` is.
+    if (IsIntegral()) {
+      if (subtract) {
+        numerator_ -= rhs.numerator_;
+      } else {
+        numerator_ += rhs.numerator_;
+      }
+    } else if (subtract) {
+      numerator_.SubMul(denominator_, rhs.numerator_);
+    } else {
+      numerator_.AddMul(denominator_, rhs.numerator_);
+    }
+    return *this;
+  }
+
+  // `rhs` may alias `*this`, so the cross term is formed before either part of
+  // `*this` changes, and the denominator is updated last.
+  Integer cross = rhs.numerator_ * denominator_;
+  numerator_ *= rhs.denominator_;
+  if (subtract) {
+    numerator_ -= cross;
+  } else {
+    numerator_ += cross;
+  }
+  if (IsIntegral()) {
+    denominator_ = rhs.denominator_;
+  } else {
+    denominator_ *= rhs.denominator_;
+  }
+  MaybeNormalize();
+  return *this;
+}
+
+Rational &Rational::operator*=(Rational const &rhs) {
+  bool integral = IsIntegral() and rhs.IsIntegral();
+  numerator_ *= rhs.numerator_;
+  if (not rhs.IsIntegral()) { denominator_ *= rhs.denominator_; }
+  if (not integral) { MaybeNormalize(); }
+  return *this;
+}
+
+Rational &Rational::operator/=(Rational const &rhs) {
+  assert(rhs.numerator_ != 0);
+  if (&rhs == this) { return *this = 1; }
+  bool negative = Integer::IsNegative(rhs.numerator_);
+  if (not rhs.IsIntegral()) { numerator_ *= rhs.denominator_; }
+  denominator_ *= rhs.numerator_;
+  if (negative) {
+    numerator_.negate();
+    denominator_.negate();
+  }
+  MaybeNormalize();
+  return *this;
+}
+
+bool operator==(Rational const &lhs, Rational const &rhs) {
+  if (lhs.IsIntegral() and rhs.IsIntegral()) {
+    return lhs.numerator_ == rhs.numerator_;
+  }
+  if (Integer::IsNegative(lhs.numerator_) !=
+      Integer::IsNegative(rhs.numerator_)) {
+    return false;
+  }
+  // Cross-multiplying is exact for any representation and cheaper than
+  // reducing either side.
+  return lhs.numerator_ * rhs.denominator_ == rhs.numerator_ * lhs.denominator_;
+}
+
+bool operator<(Rational const &lhs, Rational const &rhs) {
+  if (lhs.IsIntegral() and rhs.IsIntegral()) {
+    return lhs.numerator_ < rhs.numerator_;
+  }
+  bool lhs_negative = Integer::IsNegative(lhs.numerator_);
+  bool rhs_negative = Integer::IsNegative(rhs.numerator_);
+  if (lhs_negative != rhs_negative) { return lhs_negative; }
+  return lhs.numerator_ * rhs.denominator_ < rhs.numerator_ * lhs.denominator_;
+}
+
+std::ostream &operator<<(std::ostream &os, Rational const &r) {
+  if (r.IsIntegral()) { return os << r.numerator_; }
+  Rational reduced = r;
+  reduced.Normalize();
+  os << reduced.numerator_;
+  if (not reduced.IsIntegral()) { os << '/' << reduced.denominator_; }
+  return os;
+}
+
+}  // namespace chalk
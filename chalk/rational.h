@@ -0,0 +1,105 @@
+#ifndef CHALK_RATIONAL_H
+#define CHALK_RATIONAL_H
+
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <utility>
+
+#include "chalk/algebra/property.h"
+#include "chalk/integer.h"
+
+namespace chalk {
+
+// `Rational` is an exact rational number, represented as the quotient of an
+// `Integer` numerator by a positive `Integer` denominator.
+//
+// Reducing to lowest terms takes a greatest common divisor, which costs far
+// more than the arithmetic it simplifies, so reduction is deferred: arithmetic
+// may leave common factors in place, and the representation is reduced only
+// once it spans more than `kNormalizationLimbs` limbs and has doubled in size
+// since it was last reduced, or on request with `Normalize`. Comparisons and
+// output are exact regardless of the representation. Values whose denominator
+// is one take fast paths that never touch the denominator.
+struct Rational : Algebraic {
+  using chalk_properties = void(Ring, Commutative<'*'>);
+
+  // Integral values are always in lowest terms.
+  Rational(Integer n = 0)
+      : numerator_(std::move(n)), normalized_size_(size()) {}
+  Rational(std::integral auto n) : numerator_(n), normalized_size_(size()) {}
+
+  // Constructs `numerator / denominator`, which need not be in lowest terms.
+  // Requires `denominator` to be non-zero.
+  Rational(Integer numerator, Integer denominator);
+
+  // The numerator and positive denominator of the current representation,
+  // which is in lowest terms after a call to `Normalize` but need not be
+  // otherwise.
+  Integer const &numerator() const { return numerator_; }
+  Integer const &denominator() const { return denominator_; }
+
+  // Reduces the representation to lowest terms.
+  void Normalize();
+
+  friend bool operator==(Rational const &lhs, Rational const &rhs);
+  friend bool operator<(Rational const &lhs, Rational const &rhs);
+  friend bool operator<=(Rational const &lhs, Rational const &rhs) {
+    return not(rhs < lhs);
+  }
+  friend bool operator>(Rational const &lhs, Rational const &rhs) {
+    return rhs < lhs;
+  }
+  friend bool operator>=(Rational const &lhs, Rational const &rhs) {
+    return not(lhs < rhs);
+  }
+
+  Rational &operator+=(Rational const &rhs) { return Add(rhs, false); }
+  Rational &operator-=(Rational const &rhs) { return Add(rhs, true); }
+  Rational &operator*=(Rational const &rhs);
+
+  // Requires `rhs` to be non-zero.
+  Rational &operator/=(Rational const &rhs);
+  friend Rational operator/(Rational lhs, Rational const &rhs) {
+    lhs /= rhs;
+    return lhs;
+  }
+
+  Rational operator-() const & {
+    Rational result = *this;
+    result.numerator_.negate();
+    return result;
+  }
+  Rational operator-() && {
+    numerator_.negate();
+    return std::move(*this);
+  }
+
+  // Writes the value in lowest terms, as `n/d`, or as `n` if it is integral.
+  friend std::ostream &operator<<(std::ostream &os, Rational const &r);
+
+ private:
+  static constexpr size_t kNormalizationLimbs = 8;
+
+  bool IsIntegral() const { return denominator_ == 1; }
+
+  // Adds `rhs` to `*this`, or subtracts it if `subtract` is set.
+  Rational &Add(Rational const &rhs, bool subtract);
+
+  // Reduces the representation if it has grown enough since it was last
+  // reduced.
+  void MaybeNormalize();
+
+  // The number of limbs in the numerator and denominator together.
+  size_t size() const { return numerator_.size() + denominator_.size(); }
+
+  Integer numerator_;
+  Integer denominator_ = 1;
+  // The value of `size()` when the representation was last known to be in
+  // lowest terms, or zero if it never has been.
+  size_t normalized_size_ = 0;
+};
+
+}  // namespace chalk
+
+#endif  // CHALK_RATIONAL_H
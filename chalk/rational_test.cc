@@ -0,0 +1,138 @@
+#include "chalk/rational.h"
+
+#include <sstream>
+#include <string>
+
+#include "chalk/algebra/dense_polynomial.h"
+#include "chalk/integer.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace chalk {
+namespace {
+
+using ::testing::ElementsAre;
+
+static_assert(Satisfies<Rational, Ring>);
+static_assert(Satisfies<Rational, Commutative<'*'>>);
+
+std::string ToString(Rational const &r) {
+  std::stringstream ss;
+  ss << r;
+  return ss.str();
+}
+
+TEST(Rational, Construction) {
+  EXPECT_EQ(Rational(), 0);
+  EXPECT_EQ(Rational(5), 5);
+  EXPECT_EQ(Rational(Integer(-5)), -5);
+  EXPECT_EQ(Rational(6, 4), Rational(3, 2));
+  EXPECT_EQ(Rational(6, -4), Rational(-3, 2));
+  EXPECT_EQ(Rational(0, -7), 0);
+  EXPECT_EQ(Rational(-8, -4), 2);
+
+  Rational r(6, -4);
+  EXPECT_FALSE(Integer::IsNegative(r.denominator()));
+  r.Normalize();
+  EXPECT_EQ(r.numerator(), -3);
+  EXPECT_EQ(r.denominator(), 2);
+
+  Rational zero(0, -7);
+  zero.Normalize();
+  EXPECT_EQ(zero.numerator(), 0);
+  EXPECT_EQ(zero.denominator(), 1);
+}
+
+TEST(Rational, Comparison) {
+  EXPECT_TRUE(Rational(1, 3) < Rational(1, 2));
+  EXPECT_TRUE(Rational(-1, 2) < Rational(-1, 3));
+  EXPECT_TRUE(Rational(-1, 2) < 0);
+  EXPECT_TRUE(Rational(0) < Rational(1, 1000));
+  EXPECT_FALSE(Rational(2, 4) < Rational(1, 2));
+  EXPECT_TRUE(Rational(2, 4) <= Rational(1, 2));
+  EXPECT_TRUE(Rational(7, 2) > 3);
+  EXPECT_TRUE(Rational(7, 2) >= Rational(14, 4));
+  EXPECT_TRUE(Rational(7, 2) != Rational(7, 3));
+  EXPECT_FALSE(Rational(7, 2) != Rational(-14, -4));
+}
+
+TEST(Rational, Arithmetic) {
+  EXPECT_EQ(Rational(1, 2) + Rational(1, 3), Rational(5, 6));
+  EXPECT_EQ(Rational(1, 2) - Rational(1, 3), Rational(1, 6));
+  EXPECT_EQ(Rational(2, 3) * Rational(9, 4), Rational(3, 2));
+  EXPECT_EQ(Rational(2, 3) / Rational(-4, 9), Rational(-3, 2));
+  EXPECT_EQ(-Rational(2, 3), Rational(-2, 3));
+
+  EXPECT_EQ(Rational(1, 2) + 1, Rational(3, 2));
+  EXPECT_EQ(1 + Rational(1, 2), Rational(3, 2));
+  EXPECT_EQ(Rational(1, 2) - 1, Rational(-1, 2));
+  EXPECT_EQ(1 - Rational(1, 2), Rational(1, 2));
+  EXPECT_EQ(Rational(1, 2) * 4, 2);
+  EXPECT_EQ(Rational(1, 2) / 4, Rational(1, 8));
+  EXPECT_EQ(Rational(3) / -6, Rational(-1, 2));
+}
+
+TEST(Rational, Aliasing) {
+  Rational r(3, 4);
+  r += r;
+  EXPECT_EQ(r, Rational(3, 2));
+  r *= r;
+  EXPECT_EQ(r, Rational(9, 4));
+  r -= r;
+  EXPECT_EQ(r, 0);
+
+  Rational s(-5, 7);
+  s /= s;
+  EXPECT_EQ(s, 1);
+}
+
+TEST(Rational, IntegralValues) {
+  // Integral values never acquire a denominator other than one.
+  Rational r = 1;
+  for (int i = 1; i <= 40; ++i) {
+    r *= i;
+    r += Rational(Integer(i));
+    r -= 1;
+  }
+  EXPECT_EQ(r.denominator(), 1);
+
+  Integer expected = 1;
+  for (int i = 1; i <= 40; ++i) { expected = expected * i + i - 1; }
+  EXPECT_EQ(r.numerator(), expected);
+}
+
+TEST(Rational, LazyNormalization) {
+  // The partial sums of `1 / (k * (k + 1))` telescope to `n / (n + 1)`, so
+  // that without reduction their denominators would grow without bound.
+  Rational sum  = 0;
+  Integer bound = Pow(Integer(2), 16 * 64);
+  for (int k = 1; k <= 300; ++k) {
+    sum += Rational(1, Integer(k) * (k + 1));
+    EXPECT_LT(sum.denominator(), bound) << "k = " << k;
+  }
+  EXPECT_EQ(sum, Rational(300, 301));
+  sum.Normalize();
+  EXPECT_EQ(sum.numerator(), 300);
+  EXPECT_EQ(sum.denominator(), 301);
+}
+
+TEST(Rational, Output) {
+  EXPECT_EQ(ToString(Rational(0)), "0");
+  EXPECT_EQ(ToString(Rational(-7)), "-7");
+  EXPECT_EQ(ToString(Rational(6, -4)), "-3/2");
+  EXPECT_EQ(ToString(Rational(12, 4)), "3");
+  EXPECT_EQ(ToString(Rational(1, 3) + Rational(1, 6)), "1/2");
+}
+
+TEST(Rational, PolynomialCoefficients) {
+  using polynomial_type = DensePolynomial<Rational>;
+  polynomial_type half  = Rational(1, 2);
+  polynomial_type x     = polynomial_type::FromCoefficients({0, 1});
+  EXPECT_THAT(((half + x) * (half - x)).coefficients(),
+              ElementsAre(Rational(1, 4), 0, -1));
+  EXPECT_THAT((x * Rational(2, 3) + Rational(1, 3)).coefficients(),
+              ElementsAre(Rational(1, 3), Rational(2, 3)));
+}
+
+}  // namespace
+}  // namespace chalk
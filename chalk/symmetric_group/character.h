@@ -6,6 +6,8 @@
 #include "absl/container/flat_hash_map.h"
 #include "chalk/algebra/property.h"
 #include "chalk/combinatorics/partition.h"
+#include "chalk/integer_accumulator.h"
+#include "chalk/rational.h"
 
 namespace chalk {
 
@@ -57,18 +59,20 @@ struct SymmetricGroupCharacter : Algebraic {
     return *this = std::move(result);
   }
 
-  friend double InnerProduct(SymmetricGroupCharacter const &lhs,
-                             SymmetricGroupCharacter const &rhs) {
+  // Returns the inner product of `lhs` and `rhs`, in lowest terms.
+  friend Rational InnerProduct(SymmetricGroupCharacter const &lhs,
+                               SymmetricGroupCharacter const &rhs) {
     if (lhs.values_.empty()) { return 0; }
-    Integer result = 0;
+    IntegerAccumulator result;
     for (auto const &[partition, coefficient] : lhs.values_) {
       auto iter = rhs.values_.find(partition);
       if (iter == rhs.values_.end()) { continue; }
-      result += (iter->second * coefficient * CycleTypeCount(partition));
+      result.AddMul(CycleTypeCount(partition), iter->second * coefficient);
     }
-    // TODO: Have this return a Rational once that exists.
-    return static_cast<double>(static_cast<int64_t>(result)) /
-           static_cast<int64_t>(Factorial(lhs.values_.begin()->first.whole()));
+    Rational inner_product(result.value(),
+                           Factorial(lhs.values_.begin()->first.whole()));
+    inner_product.Normalize();
+    return inner_product;
   }
 
   friend std::ostream &operator<<(std::ostream &os,
@@ -45,8 +45,8 @@ TEST(SymmetricGroupCharacter, Four) {
 TEST(SymmetricGroupCharacter, InnerProduct) {
   auto c1111 = S::KroneckerDelta({1, 1, 1, 1});
   auto c211  = S::KroneckerDelta({2, 1, 1});
-  EXPECT_NEAR(InnerProduct(c1111 - c211, c211), -0.25, 0.0001);
-  EXPECT_NEAR(InnerProduct(c1111 + c211, c211), 0.25, 0.0001);
+  EXPECT_EQ(InnerProduct(c1111 - c211, c211), Rational(-1, 4));
+  EXPECT_EQ(InnerProduct(c1111 + c211, c211), Rational(1, 4));
   EXPECT_EQ(InnerProduct(c1111, c211), 0);
 }
 